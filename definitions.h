@@ -37,6 +37,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <cstddef>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -78,6 +79,72 @@ enum class tAutoConnectMode
   REMOTE,   //!< Connect to any remote global blackboard with the same name
 };
 
+/*! How local write locks on the complete blackboard are granted */
+enum class tBufferMode
+{
+  SINGLE_BUFFERED, //!< Writers modify current buffer in-place if possible (no copy - but read locks block during write lock)
+  MULTI_BUFFERED,  //!< Writers always modify a copy of the current buffer (read locks never block)
+  TRIPLE_BUFFERED  //!< Writers modify one of two spare buffers that becomes current buffer on commit (read locks never block; intended for a single periodic writer; not selected adaptively)
+};
+
+/*! Reason for current buffer mode of a blackboard server */
+enum class tBufferModeReason
+{
+  INITIAL,         //!< Buffer mode was selected in constructor
+  MANUAL,          //!< Buffer mode was set explicitly
+  READ_COLLISIONS, //!< Read locks frequently collided with write locks - and blocking costs more than copying
+  LOW_CONTENTION,  //!< Read locks rarely occurred during write locks
+  COPY_COST        //!< Copying buffers costs more than read locks are blocked
+};
+
+/*! Range of blackboard element indices [begin, end) - e.g. to write-lock only part of a blackboard */
+struct tElementRange
+{
+  /*! Index of first element in range */
+  size_t begin;
+
+  /*! Index after last element in range */
+  size_t end;
+
+  tElementRange(size_t begin, size_t end) :
+    begin(begin),
+    end(end)
+  {}
+};
+
+/*! Operation performed by a blackboard change (see tChange) */
+enum class tChangeOperation
+{
+  REPLACE,       //!< Replace single element
+  REPLACE_RANGE, //!< Replace range of consecutive elements
+  APPEND,        //!< Append elements to blackboard
+  INSERT,        //!< Insert elements at index (subsequent elements move back)
+  ERASE,         //!< Erase elements at index (subsequent elements move forward)
+  TRUNCATE,      //!< Remove elements that exceed a maximum size
+  RESIZE,        //!< Resize blackboard
+  ADD,           //!< Add operand to element
+  MIN,           //!< Replace element with operand if operand is smaller
+  MAX,           //!< Replace element with operand if operand is larger
+  BITWISE_OR,    //!< Combine element with operand using bitwise or
+  COMPARE_AND_SWAP //!< Replace element with new value if it equals the expected value
+};
+
+/*! Compression of blackboard elements that are transferred over the network (see tBlackboardServer::SetCompression()) */
+enum class tCompression
+{
+  NONE,             //!< Elements are not compressed
+  LZ,               //!< Fast LZ-style compression of element bytes
+  SHUFFLE_DELTA_LZ  //!< Element bytes are shuffled into byte planes and delta-encoded before LZ compression (suitable for smooth float arrays)
+};
+
+/*! Determines when blackboard servers publish changed blackboard content on their read ports */
+enum class tPublishingPolicy
+{
+  IMMEDIATE, //!< Publish after every change
+  MAX_RATE,  //!< Publish after a change - unless the last publish was less than a minimum interval ago (pending changes are published as soon as the interval has passed)
+  PERIODIC   //!< Publish all changes made during a period at the end of this period (period is set with the policy; periods are measured by the blackboard timer and independent of the cycle of the thread container owning the blackboard)
+};
+
 
 //----------------------------------------------------------------------
 // Function declarations
@@ -33,10 +33,13 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "core/tLockOrderLevel.h"
+#include <algorithm>
+#include <thread>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tBlackboardTimer.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -65,17 +68,225 @@ namespace internal
 // Const values
 //----------------------------------------------------------------------
 
-/*! Default lock timeout - if no keep-alive signal occurs in this period of time, blackboard is unlocked */
-//static constexpr rrlib::time::tDuration cDEFAULT_LOCK_TIMEOUT = std::chrono::seconds(1);
+/*! Number of write locks in sliding window for adaptive buffer mode selection */
+static const size_t cBUFFER_MODE_WINDOW_SIZE = 16;
+
+/*! Minimum number of write locks in window with colliding read locks to switch to multi-buffered mode */
+static const size_t cMULTI_BUFFERED_MIN_COLLISIONS = 4;
+
+/*! Maximum number of write locks in window with colliding read locks to switch back to single-buffered mode */
+static const size_t cSINGLE_BUFFERED_MAX_COLLISIONS = 1;
+
+/*! Factor by which blocking time must exceed copy time to switch to multi-buffered mode (and vice versa) */
+static const int cBUFFER_MODE_COST_FACTOR = 2;
 
 //----------------------------------------------------------------------
 // Implementation
 //----------------------------------------------------------------------
-tAbstractBlackboardServer::tAbstractBlackboardServer(core::tFrameworkElement* parent, const std::string& name, tFrameworkElement::tFlags flags) :
+tAbstractBlackboardServer::tAbstractBlackboardServer(core::tFrameworkElement* parent, const std::string& name, tFrameworkElement::tFlags flags, tBufferMode buffer_mode, bool adaptive_buffer_mode) :
   tFrameworkElement(parent, name, flags),
   blackboard_mutex("Blackboard", static_cast<int>(core::tLockOrderLevel::INNER_MOST) - 1000),
-  revision_counter(0)
+  revision_counter(0),
+  statistics(),
+  lock_free_read_buffer(NULL),
+  lock_free_readers_active(0),
+  lock_free_reads_enabled(true),
+  write_lock_samples(cBUFFER_MODE_WINDOW_SIZE),
+  write_lock_sample_count(0),
+  next_write_lock_sample(0),
+  buffer_mode(buffer_mode),
+  buffer_mode_reason(tBufferModeReason::INITIAL),
+  adaptive_buffer_mode(adaptive_buffer_mode),
+  average_copy_duration(rrlib::time::tDuration::zero()),
+  copy_duration_measured(false),
+  read_lock_during_write_lock(false),
+  write_lock_time(),
+  first_read_collision_time(rrlib::time::cNO_TIME),
+  write_lock_recorded(false),
+  deleting(false)
+{
+}
+
+tBufferMode tAbstractBlackboardServer::GetBufferMode()
+{
+  rrlib::thread::tLock lock(blackboard_mutex);
+  return buffer_mode;
+}
+
+tBufferModeReason tAbstractBlackboardServer::GetBufferModeReason()
+{
+  rrlib::thread::tLock lock(blackboard_mutex);
+  return buffer_mode_reason;
+}
+
+tAbstractBlackboardServer::tStatistics tAbstractBlackboardServer::GetStatistics()
+{
+  rrlib::thread::tLock lock(blackboard_mutex);
+  return statistics;
+}
+
+void tAbstractBlackboardServer::PrepareDelete()
+{
+  {
+    rrlib::thread::tLock lock(blackboard_mutex);
+    deleting = true;
+  }
+  tBlackboardTimer::Cancel(*this);  // deadlines scheduled afterwards are ignored by timer
+}
+
+void tAbstractBlackboardServer::RecordBufferCopy(const rrlib::time::tDuration& duration)
+{
+  if (copy_duration_measured)
+  {
+    average_copy_duration = (average_copy_duration * 7 + duration) / 8;
+  }
+  else
+  {
+    average_copy_duration = duration;
+    copy_duration_measured = true;
+  }
+}
+
+void tAbstractBlackboardServer::RecordWriteLock()
+{
+  write_lock_recorded = true;
+  write_lock_time = rrlib::time::Now();
+  first_read_collision_time = rrlib::time::cNO_TIME;
+  read_lock_during_write_lock.store(false, std::memory_order_relaxed);
+}
+
+void tAbstractBlackboardServer::RecordWriteUnlock(const rrlib::time::tDuration& copy_duration)
+{
+  if (!write_lock_recorded)
+  {
+    return;
+  }
+  write_lock_recorded = false;
+  rrlib::time::tTimestamp now = rrlib::time::Now();
+  if (copy_duration > rrlib::time::tDuration::zero())
+  {
+    RecordBufferCopy(copy_duration);
+  }
+
+  // Record sample
+  tWriteLockSample& sample = write_lock_samples[next_write_lock_sample];
+  if (first_read_collision_time != rrlib::time::cNO_TIME)
+  {
+    sample.read_collision = true;
+    sample.blocking_time = now - first_read_collision_time;
+  }
+  else if (read_lock_during_write_lock.load(std::memory_order_relaxed))
+  {
+    // read lock would have collided in single-buffered mode (time of read lock is not known - so this is an upper bound)
+    sample.read_collision = true;
+    sample.blocking_time = now - write_lock_time;
+  }
+  else
+  {
+    sample.read_collision = false;
+    sample.blocking_time = rrlib::time::tDuration::zero();
+  }
+  next_write_lock_sample = (next_write_lock_sample + 1) % write_lock_samples.size();
+  write_lock_sample_count = std::min(write_lock_sample_count + 1, write_lock_samples.size());
+  if ((!adaptive_buffer_mode) || buffer_mode == tBufferMode::TRIPLE_BUFFERED || write_lock_sample_count < write_lock_samples.size())
+  {
+    return;
+  }
+
+  // Evaluate window
+  size_t collisions = 0;
+  rrlib::time::tDuration blocking_time = rrlib::time::tDuration::zero();
+  for (auto & window_sample : write_lock_samples)
+  {
+    if (window_sample.read_collision)
+    {
+      collisions++;
+      blocking_time += window_sample.blocking_time;
+    }
+  }
+  rrlib::time::tDuration copy_time = average_copy_duration * write_lock_samples.size();
+  if (buffer_mode == tBufferMode::SINGLE_BUFFERED)
+  {
+    if (collisions >= cMULTI_BUFFERED_MIN_COLLISIONS &&
+        ((!copy_duration_measured) || blocking_time > copy_time * cBUFFER_MODE_COST_FACTOR))
+    {
+      SwitchBufferMode(tBufferMode::MULTI_BUFFERED, tBufferModeReason::READ_COLLISIONS);
+    }
+  }
+  else if (buffer_mode == tBufferMode::MULTI_BUFFERED)
+  {
+    if (collisions <= cSINGLE_BUFFERED_MAX_COLLISIONS)
+    {
+      SwitchBufferMode(tBufferMode::SINGLE_BUFFERED, tBufferModeReason::LOW_CONTENTION);
+    }
+    else if (copy_duration_measured && blocking_time * cBUFFER_MODE_COST_FACTOR < copy_time)
+    {
+      SwitchBufferMode(tBufferMode::SINGLE_BUFFERED, tBufferModeReason::COPY_COST);
+    }
+  }
+}
+
+void tAbstractBlackboardServer::SetBufferMode(tBufferMode mode, bool adaptive)
+{
+  rrlib::thread::tLock lock(blackboard_mutex);
+  tBufferMode previous_mode = buffer_mode;
+  buffer_mode = mode;
+  buffer_mode_reason = tBufferModeReason::MANUAL;
+  adaptive_buffer_mode = adaptive;
+  write_lock_sample_count = 0;
+  if (previous_mode != mode)
+  {
+    OnBufferModeChange(previous_mode);
+  }
+}
+
+void tAbstractBlackboardServer::SwitchBufferMode(tBufferMode mode, tBufferModeReason reason)
+{
+  FINROC_LOG_PRINT(DEBUG, "Switching to ", mode == tBufferMode::MULTI_BUFFERED ? "multi" : "single", "-buffered mode (reason: ", make_builder::GetEnumString(reason), ")");
+  buffer_mode = mode;
+  buffer_mode_reason = reason;
+  write_lock_sample_count = 0; // keep mode for at least one complete window
+  statistics.buffer_mode_switches++;
+}
+
+void tAbstractBlackboardServer::RetractLockFreeReadBuffer()
+{
+  lock_free_read_buffer.store(NULL);
+
+  // Grace period: readers that loaded the old pointer have not necessarily added their lock yet.
+  // Readers arriving after the store above see NULL and do not announce themselves - so this loop terminates under continuous read load.
+  while (lock_free_readers_active.load() > 0)
+  {
+    std::this_thread::yield();
+  }
+}
+
+void tAbstractBlackboardServer::ScheduleDeadline(const rrlib::time::tTimestamp& deadline)
+{
+  if (!deleting)
+  {
+    tBlackboardTimer::Schedule(*this, deadline);
+  }
+}
+
+data_ports::standard::tPortBufferManager* tAbstractBlackboardServer::TryLockFreeReadLock()
 {
+  if (!lock_free_reads_enabled.load(std::memory_order_relaxed))
+  {
+    return NULL;
+  }
+  if (!lock_free_read_buffer.load())
+  {
+    return NULL;  // retracted: do not announce reader (would delay writer waiting in RetractLockFreeReadBuffer())
+  }
+  lock_free_readers_active.fetch_add(1);
+  data_ports::standard::tPortBufferManager* buffer = lock_free_read_buffer.load();
+  if (buffer)
+  {
+    buffer->AddLocks(1);
+  }
+  lock_free_readers_active.fetch_sub(1);
+  return buffer;
 }
 
 
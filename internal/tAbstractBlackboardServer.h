@@ -40,10 +40,12 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "core/tFrameworkElement.h"
+#include "plugins/data_ports/standard/tPortBufferManager.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -58,6 +60,7 @@ namespace internal
 //----------------------------------------------------------------------
 // Forward declarations / typedefs / enums
 //----------------------------------------------------------------------
+class tBlackboardTimer;
 
 //----------------------------------------------------------------------
 // Class declaration
@@ -75,7 +78,73 @@ class tAbstractBlackboardServer : public core::tFrameworkElement
 //----------------------------------------------------------------------
 public:
 
-  tAbstractBlackboardServer(core::tFrameworkElement* parent, const std::string& name, tFrameworkElement::tFlags flags = tFlags());
+  /*! Statistics on blackboard server operation */
+  struct tStatistics
+  {
+    /*! Number of buffers for new blackboard content that were reused from buffers retired by this server (see tBufferFactory) */
+    uint64_t buffer_reuse_hits;
+
+    /*! Number of buffers for new blackboard content that had to be obtained from the port's buffer pool (no suitable retired buffer available) */
+    uint64_t buffer_reuse_misses;
+
+    /*! Number of deferred asynchronous changes that were not applied, because a later deferred change replaced the same element */
+    uint64_t coalesced_changes;
+
+    /*! Number of changes that were not published immediately due to the publishing policy */
+    uint64_t suppressed_publishes;
+
+    /*! Number of optimistic commits that were rejected, because blackboard content was changed (or locked) in the meantime */
+    uint64_t optimistic_commit_conflicts;
+
+    /*! Number of buffer mode switches by adaptive buffer mode selection */
+    uint64_t buffer_mode_switches;
+
+    /*! Number of remote write locks that were revoked, because their lease expired (see tBlackboardServer::SetLockLeaseDuration()) */
+    uint64_t expired_lock_leases;
+
+    /*! Number of modified chunks that writers committed instead of a complete buffer (chunked copy-on-write and remote writers that commit only changes) */
+    uint64_t committed_chunks;
+
+    tStatistics() :
+      buffer_reuse_hits(0),
+      buffer_reuse_misses(0),
+      coalesced_changes(0),
+      suppressed_publishes(0),
+      optimistic_commit_conflicts(0),
+      buffer_mode_switches(0),
+      expired_lock_leases(0),
+      committed_chunks(0)
+    {}
+
+    /*!
+     * \return Fraction of buffers for new blackboard content that were reused from retired buffers (1 if no buffers were obtained yet)
+     */
+    double GetBufferReuseHitRate() const
+    {
+      uint64_t total = buffer_reuse_hits + buffer_reuse_misses;
+      return total ? static_cast<double>(buffer_reuse_hits) / total : 1.0;
+    }
+  };
+
+  /*!
+   * \param parent Parent framework element
+   * \param name Name of blackboard
+   * \param flags Flags for framework element
+   * \param buffer_mode Initial buffer mode
+   * \param adaptive_buffer_mode Select buffer mode adaptively (see SetBufferMode())?
+   */
+  tAbstractBlackboardServer(core::tFrameworkElement* parent, const std::string& name, tFrameworkElement::tFlags flags = tFlags(),
+                            tBufferMode buffer_mode = tBufferMode::SINGLE_BUFFERED, bool adaptive_buffer_mode = false);
+
+  /*!
+   * \return Current buffer mode (see SetBufferMode())
+   */
+  tBufferMode GetBufferMode();
+
+  /*!
+   * \return Reason for current buffer mode
+   */
+  tBufferModeReason GetBufferModeReason();
 
   /*!
    * \return Revision of blackboard content (is incremented whenever blackboard content changes - signaling that a new version is available)
@@ -85,6 +154,36 @@ public:
     return revision_counter;
   }
 
+  /*!
+   * \return Current statistics on blackboard server operation
+   */
+  tStatistics GetStatistics();
+
+  /*!
+   * Sets buffer mode.
+   *
+   * With adaptive buffer mode selection (enabled by default - unless a blackboard is created with an explicit buffer mode), the server keeps track of local write locks
+   * over a sliding window: read locks that collided (or would have collided) with them, the time read locks were
+   * (or would have been) blocked, and the time spent copying buffers.
+   * It switches to multi-buffered mode, when read locks collide frequently and blocking costs more than copying.
+   * It switches back, when collisions become rare or copying costs more than blocking.
+   * Thresholds are apart from each other and a mode is kept for at least one complete window (hysteresis).
+   * Triple-buffered mode is never selected or left adaptively.
+   *
+   * \param mode Buffer mode
+   * \param adaptive Select buffer mode adaptively from now on? (otherwise, the specified mode is kept)
+   */
+  void SetBufferMode(tBufferMode mode, bool adaptive = false);
+
+  /*!
+   * \param enabled Whether read locks may be acquired without the blackboard mutex (enabled by default)
+   *                (mainly intended for benchmarking against the mutex-based read path)
+   */
+  void SetLockFreeReadsEnabled(bool enabled)
+  {
+    lock_free_reads_enabled = enabled;
+  }
+
 //----------------------------------------------------------------------
 // Protected methods
 //----------------------------------------------------------------------
@@ -98,6 +197,14 @@ protected:
     return blackboard_mutex;
   }
 
+  /*!
+   * \return Current buffer mode (may only be called in synchronized context)
+   */
+  inline tBufferMode BufferMode()
+  {
+    return buffer_mode;
+  }
+
   /*!
    * Increments revision counter by one
    */
@@ -106,13 +213,121 @@ protected:
     revision_counter++;
   }
 
-  virtual void PrepareDelete() override {}
+  /*!
+   * Stops scheduling deadlines and cancels any scheduled deadline
+   * (no more deadlines are processed afterwards)
+   */
+  virtual void PrepareDelete() override;
+
+  /*!
+   * Called by blackboard timer when deadline scheduled with ScheduleDeadline() is due
+   * (called without holding the blackboard mutex)
+   */
+  virtual void ProcessDeadlines() {}
+
+  /*!
+   * Called by SetBufferMode() when buffer mode was changed
+   * (called while holding the blackboard mutex)
+   *
+   * \param previous_mode Buffer mode before change
+   */
+  virtual void OnBufferModeChange(tBufferMode previous_mode) {}
+
+  /*!
+   * \return Statistics on blackboard server operation (may only be accessed in synchronized context)
+   */
+  tStatistics& Statistics()
+  {
+    return statistics;
+  }
+
+  /*!
+   * Makes buffer available to read locks that do not acquire the blackboard mutex
+   * (may only be called in synchronized context)
+   *
+   * \param buffer Buffer to publish (NULL to make lock-free reading unavailable)
+   */
+  inline void PublishLockFreeReadBuffer(data_ports::standard::tPortBufferManager* buffer)
+  {
+    lock_free_read_buffer.store(buffer);
+  }
+
+  /*!
+   * Records time spent on copying blackboard buffer (for adaptive buffer mode selection)
+   * (may only be called in synchronized context)
+   *
+   * \param duration Duration of copy
+   */
+  void RecordBufferCopy(const rrlib::time::tDuration& duration);
+
+  /*!
+   * Records that a read lock was blocked by an exclusive write lock (for adaptive buffer mode selection)
+   * (may only be called in synchronized context)
+   */
+  inline void RecordReadCollision()
+  {
+    if (first_read_collision_time == rrlib::time::cNO_TIME)
+    {
+      first_read_collision_time = rrlib::time::Now();
+    }
+  }
+
+  /*!
+   * Records that a read lock was requested (for adaptive buffer mode selection)
+   * (may be called without acquiring the blackboard mutex)
+   */
+  inline void RecordReadLock()
+  {
+    if (!read_lock_during_write_lock.load(std::memory_order_relaxed))
+    {
+      read_lock_during_write_lock.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+   * Records that a local write lock on the complete blackboard was granted (for adaptive buffer mode selection)
+   * (may only be called in synchronized context)
+   */
+  void RecordWriteLock();
+
+  /*!
+   * Records unlock of write lock recorded with RecordWriteLock() and possibly switches buffer mode
+   * (may only be called in synchronized context)
+   *
+   * \param copy_duration Time that writer spent on copying buffer (zero if no copy was made)
+   */
+  void RecordWriteUnlock(const rrlib::time::tDuration& copy_duration);
+
+  /*!
+   * Makes currently published buffer unavailable to lock-free read locks.
+   * Returns after all lock-free read locks in progress have completed.
+   * Must be called before current buffer is modified in-place or released by the server.
+   * (may only be called in synchronized context)
+   */
+  void RetractLockFreeReadBuffer();
+
+  /*!
+   * Schedules call to ProcessDeadlines() (replaces deadline scheduled before)
+   * (may also be called without holding the blackboard mutex; does nothing once PrepareDelete() was called)
+   *
+   * \param deadline Time when ProcessDeadlines() is to be called
+   */
+  void ScheduleDeadline(const rrlib::time::tTimestamp& deadline);
+
+  /*!
+   * Tries to obtain read lock on published buffer without acquiring the blackboard mutex
+   *
+   * \return Published buffer with one additional lock - or NULL if no buffer is available for lock-free reading
+   */
+  data_ports::standard::tPortBufferManager* TryLockFreeReadLock();
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  friend class tBlackboardTimer;
+
   /*!
    * Mutex for blackboard operations
    * (needs to be deeper than runtime - (for initial pushes etc.))
@@ -124,6 +339,82 @@ private:
    * (precisely: whenever ConsiderPublishing() is called)
    */
   std::atomic<uint64_t> revision_counter;
+
+  /*! Statistics on blackboard server operation */
+  tStatistics statistics;
+
+  /*!
+   * Buffer that may be read-locked without acquiring the blackboard mutex
+   * (NULL while blackboard is locked exclusively or current buffer is being replaced or modified)
+   */
+  std::atomic<data_ports::standard::tPortBufferManager*> lock_free_read_buffer;
+
+  /*!
+   * Number of lock-free read locks currently in progress.
+   * A retracted buffer may not be modified or released before this counter has reached zero.
+   */
+  std::atomic<unsigned int> lock_free_readers_active;
+
+  /*! Whether read locks may be acquired without the blackboard mutex */
+  std::atomic<bool> lock_free_reads_enabled;
+
+  /*! Observations on a single write lock (for adaptive buffer mode selection) */
+  struct tWriteLockSample
+  {
+    /*! Did read locks collide (or would they have collided in single-buffered mode) with write lock? */
+    bool read_collision;
+
+    /*! Time that read locks were (or would have been) blocked */
+    rrlib::time::tDuration blocking_time;
+  };
+
+  /*! Sliding window of write lock samples (ring buffer) */
+  std::vector<tWriteLockSample> write_lock_samples;
+
+  /*! Number of valid samples in write_lock_samples */
+  size_t write_lock_sample_count;
+
+  /*! Index of next sample to replace in write_lock_samples */
+  size_t next_write_lock_sample;
+
+  /*! Current buffer mode */
+  tBufferMode buffer_mode;
+
+  /*! Reason for current buffer mode */
+  tBufferModeReason buffer_mode_reason;
+
+  /*! Select buffer mode adaptively? */
+  bool adaptive_buffer_mode;
+
+  /*! Average duration of buffer copies (moving average) */
+  rrlib::time::tDuration average_copy_duration;
+
+  /*! True, if average_copy_duration contains a measured value */
+  bool copy_duration_measured;
+
+  /*! Whether read lock was requested since last write lock was granted */
+  std::atomic<bool> read_lock_during_write_lock;
+
+  /*! Time when recorded write lock was granted */
+  rrlib::time::tTimestamp write_lock_time;
+
+  /*! Time when first read lock was blocked by current write lock (cNO_TIME if none was blocked) */
+  rrlib::time::tTimestamp first_read_collision_time;
+
+  /*! True, if current write lock was recorded with RecordWriteLock() */
+  bool write_lock_recorded;
+
+  /*! True, once server is being deleted (no deadlines are scheduled anymore - see PrepareDelete()) */
+  std::atomic<bool> deleting;
+
+
+  /*!
+   * Switches to another buffer mode
+   *
+   * \param mode New buffer mode
+   * \param reason Reason for switch
+   */
+  void SwitchBufferMode(tBufferMode mode, tBufferModeReason reason);
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,287 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tBlackboardDelta.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tBlackboardDelta
+ *
+ * \b tBlackboardDelta
+ *
+ * Patch that transforms one revision of blackboard content into the next.
+ * Published by blackboard servers on their delta read port - so that
+ * clients with push updates do not need to receive the complete blackboard
+ * on every change.
+ * Keyframes contain the complete blackboard content and may be applied
+ * regardless of the receiver's revision.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tBlackboardDelta_h__
+#define __plugins__blackboard__internal__tBlackboardDelta_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
+#include "plugins/blackboard/internal/tElementOperations.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Blackboard delta
+/*!
+ * Patch that transforms one revision of blackboard content into a newer one
+ * (deltas published by the blackboard server transform a revision into the next;
+ * deltas returned by tBlackboardServer::ReadDelta() may skip revisions).
+ * Contains the new blackboard size and the elements of one contiguous
+ * range of changed elements.
+ * Keyframes contain the complete blackboard content.
+ *
+ * \tparam T Type of blackboard elements
+ */
+template <typename T>
+class tBlackboardDelta
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::vector<T> tBuffer;
+
+  tBlackboardDelta() :
+    revision(0),
+    base_revision(0),
+    keyframe(true),
+    compression(tCompression::NONE),
+    buffer_size(0),
+    offset(0),
+    elements()
+  {}
+
+  /*!
+   * Applies delta to blackboard buffer
+   * (buffer must contain revision GetBaseRevision() - unless this is a keyframe)
+   *
+   * \param buffer Buffer to apply delta to
+   */
+  void Apply(tBuffer& buffer) const
+  {
+    if (buffer.size() != buffer_size)
+    {
+      rrlib::rtti::ResizeVector(buffer, buffer_size);
+    }
+    size_t count = std::min(elements.size(), buffer_size > offset ? buffer_size - offset : 0);
+    tElementOperations<T>::Copy(elements, 0, buffer, offset, count);
+  }
+
+  /*!
+   * \param revision Revision of blackboard content that receiver currently has
+   * \return True if delta can be applied to blackboard content with this revision
+   */
+  bool IsApplicableTo(uint64_t revision) const
+  {
+    return keyframe || base_revision == revision;
+  }
+
+  /*!
+   * \return Revision of blackboard content that delta is to be applied to (irrelevant for keyframes)
+   */
+  uint64_t GetBaseRevision() const
+  {
+    return base_revision;
+  }
+
+  /*!
+   * \return Number of elements in blackboard after applying this delta
+   */
+  size_t GetBufferSize() const
+  {
+    return buffer_size;
+  }
+
+  /*!
+   * \return Number of elements contained in delta
+   */
+  size_t GetElementCount() const
+  {
+    return elements.size();
+  }
+
+  /*!
+   * \return Revision of blackboard content after applying this delta
+   */
+  uint64_t GetRevision() const
+  {
+    return revision;
+  }
+
+  /*!
+   * \return True if this delta contains the complete blackboard content
+   */
+  bool IsKeyframe() const
+  {
+    return keyframe;
+  }
+
+  /*!
+   * \param compression Compression of elements when delta is serialized
+   */
+  void SetCompression(tCompression compression)
+  {
+    this->compression = compression;
+  }
+
+  /*!
+   * Fills delta with range of elements from blackboard buffer.
+   * Storage of previously contained elements is reused.
+   *
+   * \param buffer Blackboard buffer (new revision)
+   * \param revision Revision of blackboard buffer
+   * \param begin Index of first changed element
+   * \param end Index after last changed element (is clipped to buffer size)
+   * \param keyframe Create keyframe? (if true, begin and end are ignored)
+   */
+  void Set(const tBuffer& buffer, uint64_t revision, size_t begin, size_t end, bool keyframe)
+  {
+    Set(buffer, revision, revision - 1, begin, end, keyframe);
+  }
+
+  /*!
+   * Fills delta with range of elements from blackboard buffer.
+   * Storage of previously contained elements is reused.
+   *
+   * \param buffer Blackboard buffer (new revision)
+   * \param revision Revision of blackboard buffer
+   * \param base_revision Revision of blackboard content that delta is to be applied to
+   * \param begin Index of first element that changed since base revision
+   * \param end Index after last element that changed since base revision (is clipped to buffer size)
+   * \param keyframe Create keyframe? (if true, begin and end are ignored)
+   */
+  void Set(const tBuffer& buffer, uint64_t revision, uint64_t base_revision, size_t begin, size_t end, bool keyframe)
+  {
+    this->revision = revision;
+    this->base_revision = base_revision;
+    this->keyframe = keyframe;
+    buffer_size = buffer.size();
+    if (keyframe)
+    {
+      begin = 0;
+      end = buffer.size();
+    }
+    end = std::min(end, buffer.size());
+    begin = std::min(begin, end);
+    offset = begin;
+    if (elements.size() != end - begin)
+    {
+      rrlib::rtti::ResizeVector(elements, end - begin);
+    }
+    tElementOperations<T>::Copy(buffer, begin, elements, 0, end - begin);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  template <typename U>
+  friend rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tBlackboardDelta<U>& delta);
+
+  template <typename U>
+  friend rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tBlackboardDelta<U>& delta);
+
+  /*! Revision of blackboard content after applying this delta */
+  uint64_t revision;
+
+  /*! Revision of blackboard content that delta is to be applied to (irrelevant for keyframes) */
+  uint64_t base_revision;
+
+  /*! True if this delta contains the complete blackboard content */
+  bool keyframe;
+
+  /*! Compression of elements when delta is serialized (not serialized itself - serialized elements contain the codec) */
+  tCompression compression;
+
+  /*! Number of elements in blackboard after applying this delta */
+  size_t buffer_size;
+
+  /*! Index of first element in 'elements' */
+  size_t offset;
+
+  /*! Changed elements */
+  tBuffer elements;
+};
+
+template <typename T>
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tBlackboardDelta<T>& delta)
+{
+  stream << delta.revision << delta.base_revision << delta.keyframe << static_cast<uint64_t>(delta.buffer_size) << static_cast<uint64_t>(delta.offset) << static_cast<uint64_t>(delta.elements.size());
+  tElementOperations<T>::SerializeCompressed(stream, delta.elements, 0, delta.elements.size(), delta.compression);
+  return stream;
+}
+
+template <typename T>
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tBlackboardDelta<T>& delta)
+{
+  uint64_t buffer_size, offset, element_count;
+  stream >> delta.revision >> delta.base_revision >> delta.keyframe >> buffer_size >> offset >> element_count;
+  delta.buffer_size = static_cast<size_t>(buffer_size);
+  delta.offset = static_cast<size_t>(offset);
+  if (delta.elements.size() != element_count)
+  {
+    rrlib::rtti::ResizeVector(delta.elements, static_cast<size_t>(element_count));
+  }
+  tElementOperations<T>::DeserializeCompressed(stream, delta.elements, 0, delta.elements.size());
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
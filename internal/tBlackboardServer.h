@@ -31,12 +31,30 @@
  *
  * Blackboard server implementation.
  * Can run in single-buffered and multi-buffered mode.
- * The latter is currently activated automatically, if concurrent
- * read lock operations are detected.
+ * Unless a buffer mode is specified explicitly on construction, the server
+ * switches to the latter automatically, if read locks frequently collide
+ * with write locks (and back, if they become rare - see SetBufferMode()).
  *
  * In multi-buffered mode, the blackboard server never blocks on read locks.
  * The buffer is copied on each write, which causes computational overhead, though.
  *
+ * Local read locks do not acquire the blackboard mutex unless the blackboard
+ * is locked exclusively (or current buffer is replaced at the same moment).
+ *
+ * In chunked copy-on-write mode, copies are performed chunk-wise - so that
+ * the cost of small changes does not scale with blackboard size.
+ *
+ * Optionally, deltas (changed element ranges) are published on an additional
+ * port - so that clients with push updates need not receive the complete
+ * blackboard on every change.
+ *
+ * Publishing may be rate-limited or aggregated per period (see tPublishingPolicy).
+ * Changes that are deferred by the publishing policy are published by the
+ * blackboard timer thread when they are due.
+ *
+ * Write locks may be restricted to ranges of elements (or shards).
+ * Write locks on disjoint ranges can be held concurrently.
+ *
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__blackboard__internal__tBlackboardServer_h__
@@ -45,16 +63,24 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
+#include <deque>
 #include "plugins/rpc_ports/tPromise.h"
 #include "plugins/rpc_ports/tRPCInterface.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
 #include "plugins/blackboard/tChange.h"
 #include "plugins/blackboard/internal/tAbstractBlackboardServer.h"
+#include "plugins/blackboard/internal/tBlackboardDelta.h"
+#include "plugins/blackboard/internal/tBufferFactory.h"
+#include "plugins/blackboard/internal/tChangedRange.h"
+#include "plugins/blackboard/internal/tElementOperations.h"
 #include "plugins/blackboard/internal/tLockedBuffer.h"
 #include "plugins/blackboard/internal/tLockParameters.h"
+#include "plugins/blackboard/internal/tSeqlockBuffer.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -85,8 +111,9 @@ enum class tWriteLock
 /*!
  * Blackboard server implementation.
  * Can run in single-buffered and multi-buffered mode.
- * The latter is currently activated automatically, if concurrent
- * read lock operations are detected.
+ * Unless a buffer mode is specified explicitly on construction, the server
+ * switches to the latter automatically, if read locks frequently collide
+ * with write locks (and back, if they become rare - see SetBufferMode()).
  *
  * In multi-buffered mode, the blackboard server never blocks on read locks.
  * The buffer is copied on each write, which causes computational overhead, though.
@@ -108,15 +135,29 @@ public:
   typedef tChange<T> tSingleChange;
   typedef std::vector<tSingleChange> tChangeSet;
   typedef data_ports::tPortDataPointer<tChangeSet> tChangeSetPointer;
+  typedef tBlackboardDelta<T> tDelta;
+
+  /*!
+   * \param name Name/Uid of blackboard
+   * \param parent Parent of blackboard server
+   * \param multi_buffered Create blackboard server that is fixed to multi-buffered mode?
+   *                       (otherwise, it starts in single-buffered mode and buffer mode is selected adaptively)
+   * \param elements Initial number of elements
+   * \param shared Share blackboard with other runtime environments?
+   */
+  tBlackboardServer(const std::string& name, core::tFrameworkElement* parent = NULL, bool multi_buffered = false, size_t elements = 0, bool shared = true) :
+    tBlackboardServer(name, parent, multi_buffered ? tBufferMode::MULTI_BUFFERED : tBufferMode::SINGLE_BUFFERED, elements, shared, !multi_buffered)
+  {}
 
   /*!
    * \param name Name/Uid of blackboard
    * \param parent Parent of blackboard server
-   * \param multi_buffered Create blackboard server that is in multi_buffered mode initially?
+   * \param buffer_mode Buffer mode (see tAbstractBlackboardServer::SetBufferMode())
    * \param elements Initial number of elements
    * \param shared Share blackboard with other runtime environments?
+   * \param adaptive_buffer_mode Select buffer mode adaptively - starting with buffer_mode? (otherwise, buffer mode is only changed by SetBufferMode())
    */
-  tBlackboardServer(const std::string& name, core::tFrameworkElement* parent = NULL, bool multi_buffered = false, size_t elements = 0, bool shared = true);
+  tBlackboardServer(const std::string& name, core::tFrameworkElement* parent, tBufferMode buffer_mode, size_t elements = 0, bool shared = true, bool adaptive_buffer_mode = false);
 
   virtual ~tBlackboardServer() {}
 
@@ -133,6 +174,32 @@ public:
    */
   void AsynchronousChange(tChangeSetPointer change_set);
 
+  /*!
+   * (RPC Call)
+   * Apply change transaction to blackboard asynchronously - and return results of atomic operations
+   * (see tChange::Add(), tChange::CompareAndSwap() etc.).
+   * If blackboard is locked, results are available after change set was applied on unlock.
+   *
+   * \param change_set Change set to apply
+   * \return Future with previous values of elements changed by atomic operations (in order of atomic operations in change set)
+   */
+  rpc_ports::tFuture<tBuffer> AsynchronousChangeWithResults(tChangeSetPointer change_set);
+
+  /*!
+   * (RPC Call)
+   * Optimistic commit: Applies change transaction to blackboard - but only if blackboard content
+   * has not changed since the specified content revision was obtained (see GetContentRevision()).
+   * This neither requires nor waits for a lock.
+   * The commit is also rejected if the blackboard is currently write-locked.
+   * As content revisions also count changes that are not published yet, commits do not conflict
+   * with pending publishes (see SetPublishingPolicy()).
+   *
+   * \param expected_revision Content revision of blackboard content that change set was computed from
+   * \param change_set Change set to apply
+   * \return True if change set was applied - false on conflict (change set is discarded then)
+   */
+  bool CommitIfRevision(uint64_t expected_revision, tChangeSetPointer change_set);
+
   /*!
    * (RPC Call)
    * Direct commit of new blackboard buffer
@@ -142,6 +209,24 @@ public:
    */
   void DirectCommit(tBufferPointer new_buffer);
 
+  /*!
+   * (RPC Call)
+   * \return Revision of current blackboard content (is incremented whenever a change is applied - also if it has not been published yet)
+   */
+  inline uint64_t GetContentRevision()
+  {
+    return content_revision;
+  }
+
+  /*!
+   * \return Output port that publishes deltas of blackboard content (only valid if delta publishing was enabled)
+   */
+  data_ports::tOutputPort<tDelta> GetDeltaPort()
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    return delta_port;
+  }
+
   /*!
    * \return Output port for reading current blackboard data
    */
@@ -158,6 +243,19 @@ public:
     return tAbstractBlackboardServer::GetRevisionCounter();
   }
 
+  /*!
+   * Range of elements that changed in the most recent published revision
+   * (compared to the previous one).
+   * May be used by consumers that do not need to process the complete blackboard on every change.
+   *
+   * \return Range of changed elements (complete if unknown)
+   */
+  tChangedRange GetLastChangedRange()
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    return last_changed_range;
+  }
+
   /*!
    * \return Interface port for accessing blackboard
    */
@@ -171,6 +269,19 @@ public:
    */
   //bool IsSingleBuffered();
 
+  /*!
+   * Copies current blackboard content to provided buffer - without acquiring the blackboard mutex,
+   * locking any buffer or performing an RPC call (seqlock read).
+   * Only supported for trivially copyable element types.
+   * The first call enables maintaining a seqlock-protected copy of published content
+   * (this call acquires the blackboard mutex).
+   *
+   * \param target Buffer to copy content to
+   * \param revision Content revision of copied content (see GetContentRevision()) is stored here (may be passed to CommitIfRevision())
+   * \return False if seqlock reads are not supported (element type is not trivially copyable) or not possible at the moment (blackboard is locked exclusively on first call)
+   */
+  bool ReadCopy(tBuffer& target, uint64_t& revision);
+
   /*!
    * (RPC Call)
    * Acquire read-only lock
@@ -182,7 +293,186 @@ public:
 
   /*!
    * (RPC Call)
-   * Acquire read/write lock
+   * Reads blackboard content relative to content that caller already has.
+   * Remote readers that poll the blackboard call this instead of ReadLock(), so that
+   * only elements that changed since their last read are transferred.
+   * Depending on what is smaller, the returned delta
+   * - contains no elements (content has not changed)
+   * - contains the range of elements that changed since the known revision
+   * - is a keyframe with the complete content (e.g. if known revision is too old)
+   *
+   * \param known_revision Revision of blackboard content that caller has (std::numeric_limits<uint64_t>::max() if none)
+   * \param timeout Timeout for call (relevant if blackboard is locked exclusively)
+   * \return Future on delta that transforms known revision into current content
+   */
+  rpc_ports::tFuture<tDelta> ReadDelta(uint64_t known_revision, const rrlib::time::tDuration& timeout);
+
+  /*!
+   * (RPC Call)
+   * Acquire read-only lock on retained revision of blackboard content (see SetRevisionRetention())
+   *
+   * \param revision Revision to lock (see GetRevisionCounter())
+   * \return Future on locked buffer (contains empty pointer if revision is not retained)
+   */
+  rpc_ports::tFuture<tConstBufferPointer> ReadLockAtRevision(uint64_t revision);
+
+  /*!
+   * (RPC Call)
+   * Acquire read-only lock on retained revision of blackboard content that was current at specified time (see SetRevisionRetention()).
+   * This way, e.g. fusion modules can read blackboard content that matches the timestamps of their sensor data.
+   *
+   * \param timestamp Point in time
+   * \return Future on locked buffer (contains empty pointer if no revision from this time is retained)
+   */
+  rpc_ports::tFuture<tConstBufferPointer> ReadLockAtTime(rrlib::time::tTimestamp timestamp);
+
+  /*!
+   * \return Number of shards that index space of blackboard is partitioned into
+   */
+  size_t GetShardCount()
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    return shard_count;
+  }
+
+  /*!
+   * Publishes changes that have not been published yet due to the publishing policy - without waiting until they are due
+   * (e.g. to synchronize publishing with the cycle of the thread container owning the blackboard).
+   * Has no effect while blackboard is locked exclusively (changes are published on unlock then).
+   */
+  void PublishPendingChanges();
+
+  /*!
+   * (RPC Call)
+   * Requests that the next delta published is a keyframe.
+   * Called by clients that missed deltas. If blackboard is not locked exclusively,
+   * a keyframe with the current content is published immediately.
+   */
+  void RequestDeltaKeyframe();
+
+  /*!
+   * (RPC Call)
+   * Renews lease of remote write lock (see SetLockLeaseDuration()).
+   * Remote writers that hold a lock longer than the lease duration need to call this regularly.
+   * If the lock has already been revoked, the call has no effect (and committing changes will fail).
+   *
+   * \param lock_id ID of lock (see tLockedBuffer::GetLockId())
+   */
+  void RenewLockLease(uint64_t lock_id);
+
+  /*!
+   * Enables or disables chunked copy-on-write mode.
+   *
+   * In this mode, local writers with a copy-on-write lock only copy the chunks
+   * they modify (instead of the complete buffer) and commit only these chunks.
+   * Furthermore, the server retains the previous buffer and recycles it as next
+   * current buffer - copying only the chunks that have changed in the meantime
+   * (provided that no reader holds this buffer anymore - which is never the case with revision retention enabled).
+   *
+   * \param chunk_size Number of elements per chunk (0 disables chunked copy-on-write mode)
+   */
+  void SetChunkedCopyOnWrite(size_t chunk_size);
+
+  /*!
+   * Enables or disables publishing of deltas.
+   *
+   * When enabled, every change to the blackboard is additionally published as delta
+   * (range of changed elements) on the delta port (created on first call).
+   * Every 'keyframe_interval'th delta is a keyframe containing the complete blackboard.
+   *
+   * \param keyframe_interval Interval of keyframes (0 disables delta publishing)
+   */
+  void SetDeltaPublishing(size_t keyframe_interval);
+
+  /*!
+   * Sets duration of leases for write locks that are held by remote clients.
+   *
+   * A remote client that disconnects or dies while holding a write lock would otherwise block other writers
+   * until the RPC layer reports the failure. With leases, a remote write lock that was not renewed within
+   * the lease duration (see RenewLockLease()) is revoked as soon as the lease expires (by the blackboard timer):
+   * the lock ID becomes invalid - so that a late commit is ignored - and pending requests are processed. Revoked locks are counted in statistics (expired_lock_leases).
+   *
+   * \param duration Lease duration (zero disables leases - also of locks that are currently held; default)
+   */
+  void SetLockLeaseDuration(const rrlib::time::tDuration& duration)
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    lock_lease_duration = duration;
+  }
+
+  /*!
+   * Sets policy that determines when changed blackboard content is published on the read port.
+   * While changes are not published, they accumulate in the current buffer
+   * (local read locks, however, always obtain the current buffer).
+   * The revision counter is only incremented when content is published.
+   *
+   * \param policy Publishing policy (IMMEDIATE by default)
+   * \param min_interval Minimum interval between two publishes (MAX_RATE) or period (PERIODIC - periods start now).
+   *                     With zero interval, changes are published immediately.
+   *
+   * Periods are wall-clock periods of the blackboard timer - they are not aligned with the cycle of the thread container owning the blackboard.
+   * To publish changes once per container cycle, use MAX_RATE with a long interval and call PublishPendingChanges() at the end of each cycle.
+   */
+  void SetPublishingPolicy(tPublishingPolicy policy, const rrlib::time::tDuration& min_interval = rrlib::time::tDuration::zero());
+
+  /*!
+   * Sets compression of blackboard elements that are transferred over the network:
+   * elements in deltas (see SetDeltaPublishing() and ReadDelta()) and
+   * changed elements that remote writers commit.
+   * The codec is stored with the compressed data, so receivers do not need to be configured.
+   * Small payloads - and payloads that do not get smaller - are not compressed.
+   * Only blackboards with arithmetic element types (e.g. float) are compressed.
+   *
+   * \param compression Codec to use (tCompression::NONE by default)
+   */
+  void SetCompression(tCompression compression)
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    this->compression = compression;
+  }
+
+  /*!
+   * Configures retention of published revisions (for ReadLockAtRevision() and ReadLockAtTime()).
+   * Retained revisions are published buffers that the server keeps a reference to:
+   * Unchanged content is not copied and consecutive revisions share buffers as far as
+   * the buffer mode allows - so retention costs at most one buffer per retained revision.
+   *
+   * As the previous buffer is retained, it cannot be recycled in chunked copy-on-write mode
+   * (see SetChunkedCopyOnWrite()): with retention enabled, a new current buffer is a complete copy.
+   *
+   * \param max_revisions Maximum number of revisions to retain (0 disables retention)
+   * \param max_age Revisions that have been replaced longer ago are discarded (zero for no time limit)
+   */
+  void SetRevisionRetention(size_t max_revisions, const rrlib::time::tDuration& max_age = rrlib::time::tDuration::zero());
+
+  /*!
+   * Partitions index space of blackboard into shards of equal size (the last shard may be smaller).
+   * (the shard partition is evaluated when a shard lock is requested)
+   *
+   * \param shard_count Number of shards (1 by default)
+   */
+  void SetShardCount(size_t shard_count);
+
+  /*!
+   * (RPC Call)
+   * Acquire write lock on range of shards (see SetShardCount()).
+   * This is a range write lock on the elements of these shards (see WriteLock()).
+   *
+   * \param lock_parameters Lock parameters
+   * \param first_shard Index of first shard to lock
+   * \param shard_count Number of shards to lock
+   * \return Future on locked buffer
+   */
+  rpc_ports::tFuture<tLockedBuffer<tBuffer>> ShardWriteLock(tLockParameters lock_parameters, uint32_t first_shard, uint32_t shard_count);
+
+  /*!
+   * (RPC Call)
+   * Acquire read/write lock.
+   *
+   * If lock parameters specify a range of elements, only this range is locked.
+   * Write locks on disjoint ranges can be held concurrently - with each other and with read locks.
+   * They cannot be held concurrently with write locks on the whole blackboard.
+   * Changes to elements outside of the locked range are discarded on commit. Blackboard cannot be resized.
    *
    * \param timeout Timeout for call
    * \return Future on locked buffer
@@ -208,28 +498,86 @@ private:
     /*! Promise for read lock, if read lock was requested */
     rpc_ports::tPromise<tConstBufferPointer> read_lock_promise;
 
+    /*! Was a delta requested (see ReadDelta())? */
+    bool read_delta;
+
+    /*! Promise for delta, if delta was requested */
+    rpc_ports::tPromise<tDelta> read_delta_promise;
+
+    /*! Revision of blackboard content that requester has, if delta was requested */
+    uint64_t known_revision;
+
     /*! Timeout for lock request */
     rrlib::time::tTimestamp timeout_time;
 
     /*! Is this a remote call? */
     bool remote_call;
 
+    /*! Priority of lock request */
+    int priority;
+
+    /*! Range of elements to lock [range_begin, range_end) - if write lock on range was requested (otherwise range_begin == range_end) */
+    size_t range_begin, range_end;
 
-    tLockRequest(rpc_ports::tPromise<tLockedBuffer<tBuffer>> && write_lock_promise, rrlib::time::tTimestamp timeout_time, bool remote_call) :
+
+    tLockRequest(rpc_ports::tPromise<tLockedBuffer<tBuffer>> && write_lock_promise, rrlib::time::tTimestamp timeout_time, bool remote_call, int priority,
+                 size_t range_begin = 0, size_t range_end = 0) :
       write_lock(true),
       write_lock_promise(std::move(write_lock_promise)),
       read_lock_promise(),
+      read_delta(false),
+      read_delta_promise(),
+      known_revision(0),
       timeout_time(timeout_time),
-      remote_call(remote_call)
+      remote_call(remote_call),
+      priority(priority),
+      range_begin(range_begin),
+      range_end(range_end)
     {}
 
     tLockRequest(rpc_ports::tPromise<tConstBufferPointer> && read_lock_promise, rrlib::time::tTimestamp timeout_time) :
       write_lock(false),
       write_lock_promise(),
       read_lock_promise(std::move(read_lock_promise)),
+      read_delta(false),
+      read_delta_promise(),
+      known_revision(0),
+      timeout_time(timeout_time),
+      remote_call(false), // does not matter
+      priority(0),
+      range_begin(0),
+      range_end(0)
+    {}
+
+    tLockRequest(rpc_ports::tPromise<tDelta> && read_delta_promise, uint64_t known_revision, rrlib::time::tTimestamp timeout_time) :
+      write_lock(false),
+      write_lock_promise(),
+      read_lock_promise(),
+      read_delta(true),
+      read_delta_promise(std::move(read_delta_promise)),
+      known_revision(known_revision),
       timeout_time(timeout_time),
-      remote_call(false) // does not matter
+      remote_call(false), // does not matter
+      priority(0),
+      range_begin(0),
+      range_end(0)
     {}
+
+    /*!
+     * \return True if this is a request for a write lock on a range of elements
+     */
+    bool IsRangeLock() const
+    {
+      return range_begin < range_end;
+    }
+
+    /*!
+     * \return True if this request is to be served before the other request (higher priority - or same priority and earlier deadline)
+     */
+    bool IsMoreUrgentThan(const tLockRequest& other) const
+    {
+      return priority > other.priority || (priority == other.priority && timeout_time < other.timeout_time);
+    }
   };
 
   /*! Output port for reading current blackboard data */
@@ -245,8 +593,25 @@ private:
    */
   std::vector<tChangeSetPointer> pending_change_tasks;
 
+  /*! Pending change task whose caller waits for results of atomic operations */
+  struct tPendingChangeResult
+  {
+    /*! Change set in pending_change_tasks */
+    const tChangeSet* change_set;
+
+    /*! Promise for results */
+    rpc_ports::tPromise<tBuffer> promise;
+  };
+
+  /*! Promises for results of pending change tasks (may only be accessed in synchronized context) */
+  std::vector<tPendingChangeResult> pending_change_results;
+
+  /*! Temporary list of pending changes sorted by index (member to avoid allocation; may only be accessed in synchronized context) */
+  std::vector<tSingleChange*> coalesced_changes;
+
   /*!
    * Queue with pending lock requests
+   * (sorted: most urgent request first - see tLockRequest::IsMoreUrgentThan())
    */
   std::deque<tLockRequest> pending_lock_requests;
 
@@ -267,8 +632,177 @@ private:
   /*! Future for blackboard unlock (when it is locked) */
   tUnlockFuture unlock_future;
 
-  /*! True, if blackboard server is run in single-buffered mode */
-  bool single_buffered;
+  /*!
+   * Write lock on range of elements.
+   * Handles unlock of this write lock.
+   * Objects are reused for subsequent range locks.
+   */
+  class tRangeLock : public rpc_ports::tResponseHandler<tLockedBufferData<tBuffer>>
+  {
+  public:
+
+    /*! Blackboard server that range belongs to */
+    tBlackboardServer& server;
+
+    /*! ID of current lock (0 if this object currently represents no lock) */
+    uint64_t lock_id;
+
+    /*! Range of locked elements [begin, end) */
+    size_t begin, end;
+
+    /*! Future for unlock */
+    tUnlockFuture unlock_future;
+
+    /*! Time when lease of lock expires (cNO_TIME if lock has no lease) */
+    rrlib::time::tTimestamp lease_expiry_time;
+
+    tRangeLock(tBlackboardServer& server) :
+      server(server),
+      lock_id(0),
+      begin(0),
+      end(0),
+      unlock_future(),
+      lease_expiry_time(rrlib::time::cNO_TIME)
+    {}
+
+    virtual void HandleException(rpc_ports::tFutureStatus exception_type) override
+    {
+      server.HandleRangeUnlock(*this, NULL);
+    }
+
+    virtual void HandleResponse(tLockedBufferData<tBuffer> call_result) override
+    {
+      server.HandleRangeUnlock(*this, &call_result);
+    }
+  };
+
+  /*!
+   * Range lock objects - active and unused ones
+   * (vector never shrinks, as objects might still be referenced by obsolete futures)
+   */
+  std::vector<std::unique_ptr<tRangeLock>> range_locks;
+
+  /*! Number of currently active range locks */
+  size_t active_range_locks;
+
+  /*! Number of shards that index space is partitioned into */
+  size_t shard_count;
+
+  /*! Provides buffers for new blackboard content */
+  tBufferFactory<T> buffer_factory;
+
+  /*! Number of elements per chunk in chunked copy-on-write mode (0 if disabled) */
+  size_t chunk_size;
+
+  /*! Previous current buffer - recycled as next current buffer if no longer locked by anyone else (chunked copy-on-write mode only) */
+  typename data_ports::standard::tStandardPort::tLockingManagerPointer spare_buffer;
+
+  /*! Range of elements changed since current buffer was last published */
+  tChangedRange unpublished_changed_range;
+
+  /*! Range of elements that changed in the most recent published revision */
+  tChangedRange last_changed_range;
+
+  /*! Number of published revisions whose changed ranges are kept (for ReadDelta()) */
+  static const size_t cCHANGED_RANGE_HISTORY_LENGTH = 64;
+
+  /*! Ranges of elements that changed in the most recently published revisions (entry of revision r is at index r % cCHANGED_RANGE_HISTORY_LENGTH) */
+  std::vector<tChangedRange> changed_range_history;
+
+  /*! Output port that publishes deltas of blackboard content (created when delta publishing is enabled for the first time) */
+  data_ports::tOutputPort<tDelta> delta_port;
+
+  /*! Compression of blackboard elements that are transferred over the network */
+  tCompression compression;
+
+  /*! Interval of keyframes on delta port (0 if delta publishing is disabled) */
+  size_t delta_keyframe_interval;
+
+  /*! Number of deltas published since last keyframe */
+  size_t deltas_since_keyframe;
+
+  /*! True, if next published delta should be a keyframe */
+  bool delta_keyframe_requested;
+
+  /*! Share blackboard with other runtime environments? */
+  bool shared;
+
+  /*! Policy that determines when changed blackboard content is published */
+  tPublishingPolicy publishing_policy;
+
+  /*! Minimum interval between two publishes (MAX_RATE) or period (PERIODIC) */
+  rrlib::time::tDuration min_publish_interval;
+
+  /*! Time when current buffer was last published (MAX_RATE) - or start of first publishing period (PERIODIC) */
+  rrlib::time::tTimestamp last_publish_time;
+
+  /*! True, if current buffer contains changes that have not been published yet */
+  bool publish_pending;
+
+  /*! Time when pending changes are to be published (only valid if publish_pending is true) */
+  rrlib::time::tTimestamp publish_due_time;
+
+  /*! Revision of current blackboard content (see GetContentRevision()) */
+  std::atomic<uint64_t> content_revision;
+
+  /*! Published revision that is retained by server */
+  struct tRetainedRevision
+  {
+    /*! Revision of buffer content */
+    uint64_t revision;
+
+    /*! Time when revision was published */
+    rrlib::time::tTimestamp publish_time;
+
+    /*! Retained buffer (with one lock held by server) */
+    typename data_ports::standard::tStandardPort::tLockingManagerPointer buffer;
+
+    tRetainedRevision(uint64_t revision, rrlib::time::tTimestamp publish_time, typename data_ports::standard::tStandardPort::tLockingManagerPointer && buffer) :
+      revision(revision),
+      publish_time(publish_time),
+      buffer(std::move(buffer))
+    {}
+  };
+
+  /*! Retained revisions (oldest first) */
+  std::deque<tRetainedRevision> retained_revisions;
+
+  /*! Maximum number of revisions to retain (0 if retention is disabled) */
+  size_t max_retained_revisions;
+
+  /*! Revisions that have been replaced longer ago are discarded (zero for no time limit) */
+  rrlib::time::tDuration max_retention_age;
+
+  /*! Chunks in which spare_buffer is outdated compared to current_buffer */
+  std::vector<bool> spare_outdated_chunks;
+
+  /*! True, if spare_buffer is outdated completely */
+  bool spare_outdated_completely;
+
+  /*! Spare buffer in triple-buffered mode */
+  struct tTripleBufferSpare
+  {
+    /*! Spare buffer (with one lock held by server) */
+    typename data_ports::standard::tStandardPort::tLockingManagerPointer buffer;
+
+    /*! Range of elements in which spare buffer differs from current buffer */
+    tChangedRange outdated_range;
+  };
+
+  /*! Spare buffers in triple-buffered mode (together with current buffer, there are up to three buffers) */
+  std::vector<tTripleBufferSpare> triple_buffer_spares;
+
+  /*! Spare buffer that is currently write-locked in triple-buffered mode (NULL if none) */
+  tBuffer* triple_back_buffer;
+
+  /*! Seqlock-protected copy of published content (maintained after first ReadCopy() call) */
+  tSeqlockBuffer<T> seqlock_buffer;
+
+  /*! Duration of leases for remote write locks (zero if leases are disabled) */
+  rrlib::time::tDuration lock_lease_duration;
+
+  /*! Time when lease of current write lock on the complete blackboard expires (cNO_TIME if lock has no lease) */
+  rrlib::time::tTimestamp lease_expiry_time;
 
 
   /*!
@@ -281,50 +815,195 @@ private:
   {
     for (auto it = change_set.begin(); it != change_set.end(); ++it)
     {
-      it->Apply(blackboard_buffer);
+      ApplyChange(blackboard_buffer, *it);
     }
   }
 
   /*!
-   * Applies all pending change tasks to provided buffer
+   * Applies single change to blackboard buffer
+   *
+   * \param blackboard_buffer Blackboard buffer to apply change to
+   * \param change Change to apply
+   */
+  void ApplyChange(tBuffer& blackboard_buffer, tSingleChange& change)
+  {
+    tElementRange changed_range = change.Apply(blackboard_buffer);
+    MarkChanged(changed_range.begin, changed_range.end);
+  }
+
+  /*!
+   * Applies change set to current buffer (which is copied first if it is locked by anyone else)
+   * and publishes it according to publishing policy.
+   * (may only be called in synchronized context - while blackboard is not write-locked)
+   *
+   * \param change_set Change set to apply
+   */
+  void ApplyChangeSetToCurrentBuffer(tChangeSet& change_set)
+  {
+    this->RetractLockFreeReadBuffer();
+    ApplyAsynchronousChange(GetWritableCurrentBuffer(), change_set);
+    ConsiderPublishing();
+    UpdateLockFreeReadBuffer();
+  }
+
+  /*!
+   * Applies all pending change tasks to current buffer (which is copied first if it is locked by anyone else)
+   * and publishes it according to publishing policy.
+   * (may only be called in synchronized context - after lock-free read buffer was retracted)
+   */
+  void ApplyPendingChangeTasksToCurrentBuffer()
+  {
+    ApplyPendingChangeTasks(GetWritableCurrentBuffer());
+    ConsiderPublishing();
+  }
+
+  /*!
+   * Applies all pending change tasks to provided buffer.
+   * If all pending changes are single-element replace changes, they are coalesced:
+   * Only the last change to each element is applied - in order of element indices.
+   * Otherwise, all changes are applied in order.
    *
    * \param blackboard_buffer Blackboard buffer to apply deferred changes to
    */
   void ApplyPendingChangeTasks(tBuffer& blackboard_buffer)
   {
-    for (auto it = pending_change_tasks.begin(); it != pending_change_tasks.end(); ++it)
+    for (auto & change_set : pending_change_tasks)
     {
-      ApplyAsynchronousChange(blackboard_buffer, **it);
+      for (auto & change : *change_set)
+      {
+        if (change.GetOperation() != tChangeOperation::REPLACE)
+        {
+          coalesced_changes.clear();
+          for (auto & pending_change_set : pending_change_tasks)
+          {
+            ApplyAsynchronousChange(blackboard_buffer, *pending_change_set);
+          }
+          SetPendingChangeResults();
+          pending_change_tasks.clear();
+          return;
+        }
+        if (change.GetIndex() >= 0)
+        {
+          coalesced_changes.push_back(&change);
+        }
+      }
     }
+    std::stable_sort(coalesced_changes.begin(), coalesced_changes.end(), [](const tSingleChange * a, const tSingleChange * b)
+    {
+      return a->GetIndex() < b->GetIndex();
+    });
+    size_t applied_changes = 0;
+    for (size_t i = 0; i < coalesced_changes.size(); i++)
+    {
+      if (i + 1 < coalesced_changes.size() && coalesced_changes[i + 1]->GetIndex() == coalesced_changes[i]->GetIndex())
+      {
+        continue; // element is replaced by a later change
+      }
+      ApplyChange(blackboard_buffer, *coalesced_changes[i]);
+      applied_changes++;
+    }
+    this->Statistics().coalesced_changes += coalesced_changes.size() - applied_changes;
+    coalesced_changes.clear();
+    SetPendingChangeResults();
     pending_change_tasks.clear();
   }
 
   /*!
    * Clear and discard any pending change tasks
+   * (callers waiting for results of discarded change sets receive an exception)
    */
   void ClearPendingChangeTasks()
   {
+    pending_change_results.clear();
     pending_change_tasks.clear();
   }
 
+  /*!
+   * \param now Current time
+   * \return Time when changes made now are to be published according to publishing policy (MAX_RATE or PERIODIC)
+   */
+  rrlib::time::tTimestamp ComputePublishDueTime(const rrlib::time::tTimestamp& now)
+  {
+    if (publishing_policy == tPublishingPolicy::MAX_RATE)
+    {
+      return last_publish_time + min_publish_interval;
+    }
+    auto elapsed_periods = (now - last_publish_time) / min_publish_interval;
+    return last_publish_time + (elapsed_periods + 1) * min_publish_interval;  // end of current period
+  }
+
   /*!
    * Check if updated buffer should be published and possibly do do
+   * (changes that are not published are scheduled for publishing by blackboard timer)
    */
   void ConsiderPublishing()
   {
-    //if ((!single_buffered) || read_port.GetWrapped()->GetStrategy() > 0)  // TODO: Implementation needs to publish on strategy change, too (e.g. change log blackboard)
+    if (publishing_policy == tPublishingPolicy::IMMEDIATE || min_publish_interval == rrlib::time::tDuration::zero())
+    {
+      PublishCurrentBuffer();
+      return;
+    }
+    rrlib::time::tTimestamp now = rrlib::time::Now();
+    if (!publish_pending)
+    {
+      publish_due_time = ComputePublishDueTime(now);
+    }
+    if (now >= publish_due_time)
+    {
+      PublishCurrentBuffer();
+    }
+    else
+    {
+      if (!publish_pending)
+      {
+        publish_pending = true;
+        ScheduleNextDeadline();
+      }
+      this->Statistics().suppressed_publishes++;
+    }
+  }
+
+  /*!
+   * Publishes current buffer on read port (and delta port)
+   */
+  void PublishCurrentBuffer()
+  {
+    //if (this->BufferMode() == tBufferMode::MULTI_BUFFERED || read_port.GetWrapped()->GetStrategy() > 0)  // TODO: Implementation needs to publish on strategy change, too (e.g. change log blackboard)
     {
       assert(!current_buffer->IsUnused());
       current_buffer->AddLocks(1);
       tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()), *read_port.GetWrapped());
       read_port.Publish(pointer_clone);
       this->IncrementRevisionCounter();
+      if (max_retained_revisions)
+      {
+        current_buffer->AddLocks(1);
+        retained_revisions.emplace_back(this->GetRevisionCounter(), rrlib::time::Now(),
+                                        typename data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()));
+        PruneRetainedRevisions();
+      }
+      last_changed_range = unpublished_changed_range;
+      unpublished_changed_range.Clear();
+      changed_range_history[this->GetRevisionCounter() % cCHANGED_RANGE_HISTORY_LENGTH] = last_changed_range;
+      if (seqlock_buffer.IsEnabled())
+      {
+        seqlock_buffer.Update(current_buffer->GetObject().template GetData<tBuffer>(), last_changed_range, content_revision);
+      }
+      if (delta_keyframe_interval)
+      {
+        PublishDelta(last_changed_range.IsComplete());
+      }
+      publish_pending = false;
+      if (publishing_policy == tPublishingPolicy::MAX_RATE)
+      {
+        last_publish_time = rrlib::time::Now();
+      }
     }
   }
 
   /*!
    * Copy a blackboard buffer
-   * TODO: provide factory for buffer reuse
+   * (reuses storage of target buffer and its elements)
    *
    * \param src Source Buffer
    * \param target Target Buffer
@@ -334,6 +1013,51 @@ private:
     rrlib::rtti::GenericOperations<tBuffer>::DeepCopy(src, target);
   }
 
+  /*!
+   * Creates delta that transforms known revision into current blackboard content (see ReadDelta())
+   * (may only be called in synchronized context - while blackboard is not locked exclusively)
+   *
+   * \param known_revision Revision of blackboard content that requester has
+   * \return Delta - keyframe if changed range is unknown or not smaller than complete content
+   */
+  tDelta CreateReadDelta(uint64_t known_revision)
+  {
+    const tBuffer& buffer = current_buffer->GetObject().GetData<tBuffer>();
+    uint64_t revision = this->GetRevisionCounter();
+    bool keyframe = known_revision > revision || revision - known_revision > cCHANGED_RANGE_HISTORY_LENGTH;
+    tChangedRange changed_range = unpublished_changed_range;
+    for (uint64_t r = known_revision + 1; (!keyframe) && r <= revision; r++)
+    {
+      changed_range.Add(changed_range_history[r % cCHANGED_RANGE_HISTORY_LENGTH]);
+    }
+    size_t end = std::min(changed_range.GetEnd(), buffer.size());
+    size_t begin = std::min(changed_range.GetBegin(), end);
+    keyframe |= buffer.size() > 0 && end - begin >= buffer.size();
+
+    tDelta delta;
+    delta.Set(buffer, revision, known_revision, begin, end, keyframe);
+    delta.SetCompression(compression);
+    return delta;
+  }
+
+  /*!
+   * \param change_set Change set that was applied
+   * \return Previous values of elements changed by atomic operations in change set
+   */
+  static tBuffer GetAtomicOperationResults(const tChangeSet& change_set)
+  {
+    tBuffer results;
+    for (auto & change : change_set)
+    {
+      if (change.IsAtomicOperation())
+      {
+        rrlib::rtti::ResizeVector(results, results.size() + 1);
+        tElementOperations<T>::Copy(&change.GetPreviousElement(), results, results.size() - 1, 1);
+      }
+    }
+    return results;
+  }
+
   /*!
    * If blackboard is currently locked, defers change set
    * execution until blackboard is unlocked again
@@ -343,10 +1067,148 @@ private:
     pending_change_tasks.push_back(std::move(change_set));
   }
 
+  /*!
+   * Provides results to callers waiting for results of pending change tasks
+   * (to be called after pending change tasks were applied)
+   */
+  void SetPendingChangeResults()
+  {
+    for (auto & pending_result : pending_change_results)
+    {
+      pending_result.promise.SetValue(GetAtomicOperationResults(*pending_result.change_set));
+    }
+    pending_change_results.clear();
+  }
+
   virtual void HandleException(rpc_ports::tFutureStatus exception_type) override;
 
+  /*!
+   * \param remote_call Is lock granted to remote client?
+   * \return Lease expiry time for lock that is granted now (cNO_TIME if lock has no lease)
+   */
+  rrlib::time::tTimestamp LeaseExpiryTime(bool remote_call)
+  {
+    return (remote_call && lock_lease_duration > rrlib::time::tDuration::zero()) ? (rrlib::time::Now() + lock_lease_duration) : rrlib::time::cNO_TIME;
+  }
+
   virtual void HandleResponse(tLockedBufferData<tBuffer> call_result) override;
 
+  /*!
+   * Handles unlock of write lock on range
+   *
+   * \param lock Range lock
+   * \param unlock_data Committed data (NULL if lock was released due to exception)
+   */
+  void HandleRangeUnlock(tRangeLock& lock, tLockedBufferData<tBuffer>* unlock_data);
+
+  /*!
+   * \return True if there is a pending request for a write lock on the whole blackboard
+   */
+  bool HasPendingWriteLockRequest()
+  {
+    for (auto & request : pending_lock_requests)
+    {
+      if (request.write_lock && (!request.IsRangeLock()))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*!
+   * Discards retained revisions that exceed maximum number or age
+   */
+  void PruneRetainedRevisions()
+  {
+    while (retained_revisions.size() > max_retained_revisions)
+    {
+      retained_revisions.pop_front();
+    }
+    if (max_retention_age > rrlib::time::tDuration::zero())
+    {
+      // a revision is needed until it has been replaced for longer than max_retention_age
+      rrlib::time::tTimestamp oldest_needed = rrlib::time::Now() - max_retention_age;
+      while (retained_revisions.size() > 1 && retained_revisions[1].publish_time < oldest_needed)
+      {
+        retained_revisions.pop_front();
+      }
+    }
+  }
+
+  /*!
+   * \param begin Index of first element
+   * \param end Index after last element
+   * \return True if no element in the specified range is locked by a range lock
+   */
+  bool RangeUnlocked(size_t begin, size_t end)
+  {
+    for (auto & lock : range_locks)
+    {
+      if (lock->lock_id && begin < lock->end && lock->begin < end)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  /*!
+   * Marks current buffer as completely changed
+   */
+  void MarkAllChanged()
+  {
+    content_revision++;
+    spare_outdated_completely = true;
+    unpublished_changed_range.AddAll();
+    for (auto & spare : triple_buffer_spares)
+    {
+      spare.outdated_range.AddAll();
+    }
+  }
+
+  /*!
+   * Marks elements in current buffer as changed
+   *
+   * \param begin Index of first changed element
+   * \param end Index after last changed element
+   */
+  void MarkChanged(size_t begin, size_t end)
+  {
+    if (begin < end)
+    {
+      content_revision++;
+    }
+    unpublished_changed_range.Add(begin, end);
+    for (auto & spare : triple_buffer_spares)
+    {
+      spare.outdated_range.Add(begin, end);
+    }
+    if (chunk_size && begin < end && (!spare_outdated_completely))
+    {
+      size_t last_chunk = (end - 1) / chunk_size;
+      if (spare_outdated_chunks.size() <= last_chunk)
+      {
+        spare_outdated_chunks.resize(last_chunk + 1, false);
+      }
+      for (size_t i = begin / chunk_size; i <= last_chunk; i++)
+      {
+        spare_outdated_chunks[i] = true;
+      }
+    }
+  }
+
+  /*!
+   * \return Content of current buffer - after replacing it with a unique copy, if it is locked by anyone else
+   */
+  tBuffer& GetWritableCurrentBuffer()
+  {
+    if (!current_buffer->Unique())
+    {
+      NewCurrentBuffer(true);
+    }
+    return current_buffer->GetObject().GetData<tBuffer>();
+  }
+
   /*!
    * Replaces 'current_buffer' with new buffer that is unique
    *
@@ -354,31 +1216,345 @@ private:
    */
   void NewCurrentBuffer(bool copy_current_buffer)
   {
-    data_ports::standard::tStandardPort::tUnusedManagerPointer unused_buffer = read_port.GetWrapped()->GetUnusedBufferRaw();
-    unused_buffer->SetUnused(false);
-    unused_buffer->InitReferenceCounter(1);
+    if (this->BufferMode() == tBufferMode::TRIPLE_BUFFERED)
+    {
+      tTripleBufferSpare* spare = ObtainTripleBufferSpare(copy_current_buffer);
+      if (spare)
+      {
+        std::swap(current_buffer, spare->buffer);
+        spare->outdated_range.Clear();
+        if (!copy_current_buffer)
+        {
+          spare->outdated_range.AddAll();
+        }
+        return;
+      }
+    }
+
+    if (spare_buffer && spare_buffer->Unique())
+    {
+      // Recycle previous buffer: only chunks that changed in the meantime need to be copied
+      if (copy_current_buffer)
+      {
+        const tBuffer& current = current_buffer->GetObject().GetData<tBuffer>();
+        tBuffer& spare = spare_buffer->GetObject().GetData<tBuffer>();
+        if (spare_outdated_completely || spare.size() != current.size())
+        {
+          rrlib::time::tTimestamp copy_start = rrlib::time::Now();
+          CopyBlackboardBuffer(current, spare);
+          this->RecordBufferCopy(rrlib::time::Now() - copy_start);
+        }
+        else
+        {
+          for (size_t chunk = 0; chunk < spare_outdated_chunks.size(); chunk++)
+          {
+            if (spare_outdated_chunks[chunk])
+            {
+              size_t begin = std::min(current.size(), chunk * chunk_size);
+              size_t end = std::min(current.size(), (chunk + 1) * chunk_size);
+              tElementOperations<T>::Copy(current, begin, spare, begin, end - begin);
+            }
+          }
+        }
+      }
+      std::swap(current_buffer, spare_buffer);
+      spare_outdated_chunks.assign(spare_outdated_chunks.size(), false);
+      spare_outdated_completely = !copy_current_buffer;
+      return;
+    }
+
+    rrlib::time::tTimestamp copy_start = copy_current_buffer ? rrlib::time::Now() : rrlib::time::cNO_TIME;
+    typename tBufferFactory<T>::tBufferManagerPointer new_buffer =
+      buffer_factory.GetBuffer(*read_port.GetWrapped(), copy_current_buffer ? &current_buffer->GetObject().GetData<tBuffer>() : NULL);
     if (copy_current_buffer)
     {
-      CopyBlackboardBuffer(current_buffer->GetObject().GetData<tBuffer>(), unused_buffer->GetObject().GetData<tBuffer>());
+      this->RecordBufferCopy(rrlib::time::Now() - copy_start);
+    }
+    if (chunk_size)
+    {
+      buffer_factory.Recycle(std::move(spare_buffer));
+      spare_buffer = std::move(current_buffer);
+      spare_outdated_chunks.assign(spare_outdated_chunks.size(), false);
+      spare_outdated_completely = !copy_current_buffer;
+    }
+    else
+    {
+      buffer_factory.Recycle(std::move(current_buffer));
+    }
+    current_buffer = std::move(new_buffer);
+  }
+
+  /*!
+   * Obtains spare buffer in triple-buffered mode that is not locked by anyone else
+   * (a new spare buffer is created if there are less than two)
+   *
+   * \param update_content Update content of spare buffer to match current buffer? (only elements that differ are copied)
+   * \return Spare buffer - or NULL if no such buffer is available
+   */
+  tTripleBufferSpare* ObtainTripleBufferSpare(bool update_content)
+  {
+    const tBuffer& current = current_buffer->GetObject().GetData<tBuffer>();
+    for (auto & spare : triple_buffer_spares)
+    {
+      if (spare.buffer->Unique())
+      {
+        if (update_content)
+        {
+          tBuffer& spare_content = spare.buffer->GetObject().template GetData<tBuffer>();
+          if (spare.outdated_range.IsComplete() || spare_content.size() != current.size())
+          {
+            CopyBlackboardBuffer(current, spare_content);
+          }
+          else
+          {
+            size_t end = std::min(spare.outdated_range.GetEnd(), current.size());
+            size_t begin = std::min(spare.outdated_range.GetBegin(), end);
+            tElementOperations<T>::Copy(current, begin, spare_content, begin, end - begin);
+          }
+          spare.outdated_range.Clear();
+        }
+        return &spare;
+      }
+    }
+    if (triple_buffer_spares.size() >= 2)
+    {
+      return NULL;
+    }
+
+    triple_buffer_spares.emplace_back();
+    tTripleBufferSpare& spare = triple_buffer_spares.back();
+    spare.buffer = buffer_factory.GetBuffer(*read_port.GetWrapped(), update_content ? &current : NULL);
+    spare.outdated_range.Clear();
+    if (!update_content)
+    {
+      spare.outdated_range.AddAll();
+    }
+    return &spare;
+  }
+
+  /*!
+   * Releases spare buffers of triple-buffered mode when server is no longer in this mode
+   * (spare buffer currently write-locked is released when the write lock is)
+   */
+  void ReleaseTripleBufferSpares()
+  {
+    if (this->BufferMode() == tBufferMode::TRIPLE_BUFFERED)
+    {
+      return;
+    }
+    for (auto it = triple_buffer_spares.begin(); it != triple_buffer_spares.end();)
+    {
+      if (triple_back_buffer && &it->buffer->GetObject().template GetData<tBuffer>() == triple_back_buffer)
+      {
+        ++it;
+      }
+      else
+      {
+        it = triple_buffer_spares.erase(it);
+      }
+    }
+  }
+
+  virtual void OnBufferModeChange(tBufferMode previous_mode) override
+  {
+    if (previous_mode == tBufferMode::TRIPLE_BUFFERED)
+    {
+      ReleaseTripleBufferSpares();
     }
-    current_buffer.reset(unused_buffer.release());
   }
 
   virtual void PrepareDelete() override
   {
+    tAbstractBlackboardServer::PrepareDelete();  // no more deadlines are processed afterwards
     {
       rrlib::thread::tLock lock(this->BlackboardMutex());
+      this->RetractLockFreeReadBuffer();
       lock_id = std::numeric_limits<uint64_t>::max();
       unlock_future = tUnlockFuture();
+      ReleaseRangeLocks();
+      spare_buffer.reset();
+      retained_revisions.clear();
+      triple_buffer_spares.clear();
+      buffer_factory.Clear();
+    }
+  }
+
+  /*!
+   * Enqueues lock request in pending lock requests (sorted by urgency)
+   *
+   * \param request Lock request to enqueue
+   */
+  void EnqueueLockRequest(tLockRequest && request)
+  {
+    auto position = pending_lock_requests.begin();
+    while (position != pending_lock_requests.end() && (!request.IsMoreUrgentThan(*position)))
+    {
+      ++position;
+    }
+    pending_lock_requests.insert(position, std::move(request));
+    ScheduleNextDeadline();
+  }
+
+  /*!
+   * Releases write lock on range
+   * (commits for this lock are ignored afterwards)
+   *
+   * \param lock Range lock to release
+   */
+  void ReleaseRangeLock(tRangeLock& lock)
+  {
+    active_range_locks--;
+    lock.lock_id = 0;
+    lock.unlock_future = tUnlockFuture(); // remove handler
+  }
+
+  /*!
+   * Releases write lock on the complete blackboard without a commit
+   * (any changes by the writer are discarded; pending changes and lock requests are processed)
+   * (may only be called in synchronized context)
+   */
+  void ReleaseWriteLock();
+
+  /*!
+   * Releases all write locks on ranges
+   */
+  void ReleaseRangeLocks()
+  {
+    for (auto & lock : range_locks)
+    {
+      if (lock->lock_id)
+      {
+        ReleaseRangeLock(*lock);
+      }
+    }
+  }
+
+  /*!
+   * Removes pending lock requests whose timeout has expired
+   * (their promises are broken, which signals failure to the waiting clients;
+   * called by blackboard timer when the earliest timeout is due - and on lock operations)
+   */
+  void RemoveExpiredLockRequests()
+  {
+    if (pending_lock_requests.empty())
+    {
+      return;
+    }
+    rrlib::time::tTimestamp now = rrlib::time::Now();
+    for (auto it = pending_lock_requests.begin(); it != pending_lock_requests.end();)
+    {
+      it = (now >= it->timeout_time) ? pending_lock_requests.erase(it) : (it + 1);
+    }
+  }
+
+  /*!
+   * Revokes write locks whose lease has expired (see SetLockLeaseDuration())
+   * (may only be called in synchronized context)
+   */
+  void RevokeExpiredLockLeases();
+
+  /*!
+   * Schedules call to ProcessDeadlines() for next time-based task (pending publish, lock request timeout or lock lease expiry)
+   * (may only be called in synchronized context)
+   */
+  void ScheduleNextDeadline()
+  {
+    rrlib::time::tTimestamp deadline = rrlib::time::cNO_TIME;
+    if (publish_pending && write_lock != tWriteLock::EXCLUSIVE)  // otherwise, changes are published on unlock
+    {
+      deadline = publish_due_time;
+    }
+    for (auto & request : pending_lock_requests)
+    {
+      if (deadline == rrlib::time::cNO_TIME || request.timeout_time < deadline)
+      {
+        deadline = request.timeout_time;
+      }
+    }
+    if (write_lock != tWriteLock::NONE && lease_expiry_time != rrlib::time::cNO_TIME && (deadline == rrlib::time::cNO_TIME || lease_expiry_time < deadline))
+    {
+      deadline = lease_expiry_time;
+    }
+    for (auto & range_lock : range_locks)
+    {
+      if (range_lock->lock_id && range_lock->lease_expiry_time != rrlib::time::cNO_TIME && (deadline == rrlib::time::cNO_TIME || range_lock->lease_expiry_time < deadline))
+      {
+        deadline = range_lock->lease_expiry_time;
+      }
+    }
+    if (deadline != rrlib::time::cNO_TIME)
+    {
+      this->ScheduleDeadline(deadline);
     }
-    tAbstractBlackboardServer::PrepareDelete();
   }
 
   /*!
-   * Processes deferred lock requests
+   * \return Number of elements per shard (the last shard may have less elements)
+   */
+  size_t ShardSize()
+  {
+    size_t size = current_buffer->GetObject().GetData<tBuffer>().size();
+    return std::max<size_t>(1, (size + shard_count - 1) / shard_count);
+  }
+
+  /*!
+   * Grants or enqueues request for write lock on range
+   *
+   * \param promise Promise to set locked buffer in
+   * \param lock_parameters Lock parameters
+   * \param begin Index of first element to lock
+   * \param end Index after last element to lock
+   */
+  void RangeWriteLock(rpc_ports::tPromise<tLockedBuffer<tBuffer>>& promise, const tLockParameters& lock_parameters, size_t begin, size_t end);
+
+  /*!
+   * Grants write lock on range
+   *
+   * \param promise Promise to set locked buffer in
+   * \param remote_call Is this a remote call?
+   * \param begin Index of first element to lock
+   * \param end Index after last element to lock
+   */
+  void RangeWriteLockImplementation(rpc_ports::tPromise<tLockedBuffer<tBuffer>>& promise, bool remote_call, size_t begin, size_t end);
+
+  /*!
+   * Publishes last change (or complete current buffer) on delta port
+   * (may only be called in synchronized context)
+   *
+   * \param keyframe Publish keyframe? (is also published if requested or keyframe interval is reached)
+   */
+  void PublishDelta(bool keyframe)
+  {
+    keyframe |= delta_keyframe_requested || deltas_since_keyframe + 1 >= delta_keyframe_interval;
+    data_ports::tPortDataPointer<tDelta> delta = delta_port.GetUnusedBuffer();
+    delta->Set(current_buffer->GetObject().GetData<tBuffer>(), this->GetRevisionCounter(), last_changed_range.GetBegin(), last_changed_range.GetEnd(), keyframe);
+    delta->SetCompression(compression);
+    delta_port.Publish(delta);
+    deltas_since_keyframe = keyframe ? 0 : (deltas_since_keyframe + 1);
+    delta_keyframe_requested = false;
+  }
+
+  /*!
+   * Revokes locks with expired leases, removes expired lock requests and publishes pending changes that are due
+   */
+  virtual void ProcessDeadlines() override;
+
+  /*!
+   * Processes deferred lock requests:
+   * Expired requests are removed, all pending read locks are granted in one batch
+   * and the most urgent pending write lock is granted.
    */
   void ProcessPendingLockRequests();
 
+  /*!
+   * Publishes current buffer for lock-free read locks - unless blackboard is locked exclusively
+   * (counterpart to RetractLockFreeReadBuffer(); may only be called in synchronized context)
+   */
+  void UpdateLockFreeReadBuffer()
+  {
+    this->PublishLockFreeReadBuffer(write_lock == tWriteLock::EXCLUSIVE ? NULL : current_buffer.get());
+  }
+
   /*!
    * Common functionality needed in WriteLock and ProcessPendingLockRequests functions
    */
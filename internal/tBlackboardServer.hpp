@@ -70,17 +70,49 @@ inline core::tFrameworkElement::tFlags GenerateConstructorFlags(bool shared)
 }
 
 template <typename T>
-tBlackboardServer<T>::tBlackboardServer(const std::string& name, core::tFrameworkElement* parent, bool multi_buffered, size_t elements, bool shared) :
-  tAbstractBlackboardServer(parent, name, GenerateConstructorFlags(shared)),
+tBlackboardServer<T>::tBlackboardServer(const std::string& name, core::tFrameworkElement* parent, tBufferMode buffer_mode, size_t elements, bool shared, bool adaptive_buffer_mode) :
+  tAbstractBlackboardServer(parent, name, GenerateConstructorFlags(shared), buffer_mode, adaptive_buffer_mode),
   read_port("read", this, core::tFrameworkElement::tFlag::FINSTRUCT_READ_ONLY | GenerateConstructorFlags(shared)),
   write_port(rpc_ports::tServerPort<tBlackboardServer<T>>(*this, "write", this, GetRPCInterfaceType(), GenerateConstructorFlags(shared))),
   pending_change_tasks(),
+  pending_change_results(),
+  coalesced_changes(),
   pending_lock_requests(),
   current_buffer(read_port.GetWrapped()->GetCurrentValueRaw()),
   lock_id(0),
   write_lock(tWriteLock::NONE),
   unlock_future(),
-  single_buffered(!multi_buffered)
+  range_locks(),
+  active_range_locks(0),
+  shard_count(1),
+  buffer_factory(this->Statistics()),
+  chunk_size(0),
+  spare_buffer(),
+  unpublished_changed_range(),
+  last_changed_range(tChangedRange::Complete()),
+  changed_range_history(cCHANGED_RANGE_HISTORY_LENGTH),
+  delta_port(),
+  compression(tCompression::NONE),
+  delta_keyframe_interval(0),
+  deltas_since_keyframe(0),
+  delta_keyframe_requested(false),
+  shared(shared),
+  publishing_policy(tPublishingPolicy::IMMEDIATE),
+  min_publish_interval(rrlib::time::tDuration::zero()),
+  last_publish_time(),
+  publish_pending(false),
+  publish_due_time(),
+  content_revision(0),
+  retained_revisions(),
+  max_retained_revisions(0),
+  max_retention_age(rrlib::time::tDuration::zero()),
+  spare_outdated_chunks(),
+  spare_outdated_completely(true),
+  triple_buffer_spares(),
+  triple_back_buffer(NULL),
+  seqlock_buffer(),
+  lock_lease_duration(rrlib::time::tDuration::zero()),
+  lease_expiry_time(rrlib::time::cNO_TIME)
 {
   read_port.Init();
   write_port.Init();
@@ -92,6 +124,7 @@ tBlackboardServer<T>::tBlackboardServer(const std::string& name, core::tFramewor
     current_buffer = read_port.GetWrapped()->GetCurrentValueRaw();
   }
   assert(!current_buffer->IsUnused());
+  UpdateLockFreeReadBuffer();
 }
 
 template <typename T>
@@ -100,25 +133,61 @@ void tBlackboardServer<T>::AsynchronousChange(tChangeSetPointer change_set)
   if (change_set)
   {
     rrlib::thread::tLock lock(this->BlackboardMutex());
-    if (write_lock != tWriteLock::NONE)
+    RevokeExpiredLockLeases();
+    if (write_lock != tWriteLock::NONE || active_range_locks > 0)
     {
       this->DeferAsynchronousChange(std::move(change_set));
+      RemoveExpiredLockRequests();
     }
     else
     {
-      // Update internal buffer?
-      if (!current_buffer->Unique())
-      {
-        NewCurrentBuffer(true);
-      }
+      ApplyChangeSetToCurrentBuffer(*change_set);
+    }
+  }
+}
 
-      // Apply change
-      this->ApplyAsynchronousChange(current_buffer->GetObject().GetData<tBuffer>(), *change_set);
+template <typename T>
+rpc_ports::tFuture<typename tBlackboardServer<T>::tBuffer> tBlackboardServer<T>::AsynchronousChangeWithResults(tChangeSetPointer change_set)
+{
+  rpc_ports::tPromise<tBuffer> promise;
+  rpc_ports::tFuture<tBuffer> future = promise.GetFuture();
+  if (!change_set)
+  {
+    promise.SetValue(tBuffer());
+    return future;
+  }
 
-      // Publish current buffer
-      ConsiderPublishing();
-    }
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
+  if (write_lock != tWriteLock::NONE || active_range_locks > 0)
+  {
+    pending_change_results.push_back(tPendingChangeResult { change_set.get(), std::move(promise) });
+    this->DeferAsynchronousChange(std::move(change_set));
+    RemoveExpiredLockRequests();
+    return future;
   }
+
+  ApplyChangeSetToCurrentBuffer(*change_set);
+  promise.SetValue(GetAtomicOperationResults(*change_set));
+  return future;
+}
+
+template <typename T>
+bool tBlackboardServer<T>::CommitIfRevision(uint64_t expected_revision, tChangeSetPointer change_set)
+{
+  if (!change_set)
+  {
+    return false;
+  }
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
+  if (content_revision != expected_revision || write_lock != tWriteLock::NONE || active_range_locks > 0)
+  {
+    this->Statistics().optimistic_commit_conflicts++;
+    return false;
+  }
+  ApplyChangeSetToCurrentBuffer(*change_set);
+  return true;
 }
 
 template <typename T>
@@ -127,6 +196,8 @@ void tBlackboardServer<T>::DirectCommit(tBufferPointer new_buffer)
   if (new_buffer)
   {
     rrlib::thread::tLock lock(this->BlackboardMutex());
+    RevokeExpiredLockLeases();
+    this->RetractLockFreeReadBuffer();
 
     // Clear any asynch change commands from queue, since they were for old buffer
     this->ClearPendingChangeTasks();
@@ -135,17 +206,21 @@ void tBlackboardServer<T>::DirectCommit(tBufferPointer new_buffer)
     lock_id++; // any current lock is obsolete, since we have completely new buffer
     write_lock = tWriteLock::NONE;
     unlock_future = tUnlockFuture(); // remove handler
+    triple_back_buffer = NULL;
+    ReleaseRangeLocks();
     if (!current_buffer->Unique())
     {
       NewCurrentBuffer(false);
     }
     std::swap(*new_buffer, current_buffer->GetObject().GetData<tBuffer>());
+    MarkAllChanged();
 
     // Publish current buffer
     ConsiderPublishing();
 
     // Any pending lock requests?
     this->ProcessPendingLockRequests();
+    UpdateLockFreeReadBuffer();
   }
 }
 
@@ -154,7 +229,11 @@ rrlib::rtti::tType tBlackboardServer<T>::GetRPCInterfaceType()
 {
   static rpc_ports::tRPCInterfaceType<tBlackboardServer<T>> type("Blackboard<" + rrlib::rtti::tDataType<T>().GetName() + ">",
       &tBlackboardServer<T>::AsynchronousChange, &tBlackboardServer<T>::DirectCommit, &tBlackboardServer<T>::ReadLock,
-      &tBlackboardServer<T>::WriteLock, &tBlackboardServer<T>::GetRevisionCounter);
+      &tBlackboardServer<T>::WriteLock, &tBlackboardServer<T>::GetRevisionCounter, &tBlackboardServer<T>::RequestDeltaKeyframe,
+      &tBlackboardServer<T>::ShardWriteLock, &tBlackboardServer<T>::CommitIfRevision,
+      &tBlackboardServer<T>::ReadLockAtRevision, &tBlackboardServer<T>::ReadLockAtTime,
+      &tBlackboardServer<T>::AsynchronousChangeWithResults, &tBlackboardServer<T>::ReadDelta, &tBlackboardServer<T>::RenewLockLease,
+      &tBlackboardServer<T>::GetContentRevision);
   return type;
 }
 
@@ -166,35 +245,50 @@ void tBlackboardServer<T>::HandleException(rpc_ports::tFutureStatus exception_ty
   {
     FINROC_LOG_PRINT(DEBUG, "Blackboard unlock due to exception: ", make_builder::GetEnumString(exception_type));
   }
+  ReleaseWriteLock();
+}
 
+template <typename T>
+void tBlackboardServer<T>::ReleaseWriteLock()
+{
+  this->RetractLockFreeReadBuffer();
   lock_id++;
   write_lock = tWriteLock::NONE;
   unlock_future = tUnlockFuture(); // remove handler
-
-  // Apply any pending changes
-  if (pending_change_tasks.size() > 0)
+  this->RecordWriteUnlock(rrlib::time::tDuration::zero());
+  if (triple_back_buffer)
   {
-    // Update internal buffer?
-    if (!current_buffer->Unique())
+    // writer might have modified back buffer without committing
+    for (auto & spare : triple_buffer_spares)
     {
-      NewCurrentBuffer(true);
+      if (&spare.buffer->GetObject().template GetData<tBuffer>() == triple_back_buffer)
+      {
+        spare.outdated_range.AddAll();
+      }
     }
+    triple_back_buffer = NULL;
+    ReleaseTripleBufferSpares();
+  }
 
-    // Apply changes
-    this->ApplyPendingChangeTasks(current_buffer->GetObject().GetData<tBuffer>());
-
-    // publish buffer
-    ConsiderPublishing();
+  // Apply any pending changes
+  if (pending_change_tasks.size() > 0)
+  {
+    ApplyPendingChangeTasksToCurrentBuffer();
+  }
+  else
+  {
+    ScheduleNextDeadline();  // changes that became due during exclusive lock
   }
 
   // Any pending lock requests?
   this->ProcessPendingLockRequests();
+  UpdateLockFreeReadBuffer();
 }
 
 template <typename T>
 void tBlackboardServer<T>::HandleResponse(tLockedBufferData<tBuffer> unlock_data)
 {
-  if (!unlock_data.buffer)
+  if ((!unlock_data.buffer) && unlock_data.modified_chunks.empty())
   {
     HandleException(rpc_ports::tFutureStatus::READY);
     //FINROC_LOG_PRINT(WARNING, "Blackboard unlock without providing buffer");
@@ -207,21 +301,73 @@ void tBlackboardServer<T>::HandleResponse(tLockedBufferData<tBuffer> unlock_data
     FINROC_LOG_PRINT(DEBUG, "Skipping outdated unlock");
     return;
   }
-
-  // Apply any pending changes
-  this->ApplyPendingChangeTasks(*unlock_data.buffer);
+  this->RetractLockFreeReadBuffer();
 
   // Update internal variables
   lock_id++;
   write_lock = tWriteLock::NONE;
   unlock_future = tUnlockFuture(); // remove handler
-  if (unlock_data.buffer.get() != &current_buffer->GetObject().GetData<tBuffer>())
+  this->RecordWriteUnlock(unlock_data.copy_duration);
+  if (unlock_data.buffer)
   {
-    if (!current_buffer->Unique())
+    // Apply any pending changes
+    this->ApplyPendingChangeTasks(*unlock_data.buffer);
+
+    // Triple-buffered mode: back buffer becomes current buffer (previous current buffer becomes spare buffer)
+    if (triple_back_buffer == unlock_data.buffer.get())
     {
-      NewCurrentBuffer(false);
+      for (auto & spare : triple_buffer_spares)
+      {
+        if (&spare.buffer->GetObject().template GetData<tBuffer>() == triple_back_buffer)
+        {
+          // spare.outdated_range contains changes applied above - changes by writer are added below
+          std::swap(spare.buffer, current_buffer);
+        }
+      }
+    }
+    triple_back_buffer = NULL;
+    ReleaseTripleBufferSpares();
+
+    if (unlock_data.buffer.get() != &current_buffer->GetObject().GetData<tBuffer>())
+    {
+      if (!current_buffer->Unique())
+      {
+        NewCurrentBuffer(false);
+      }
+      std::swap(*unlock_data.buffer, current_buffer->GetObject().GetData<tBuffer>());
+    }
+    if (unlock_data.changed_range.IsComplete())
+    {
+      MarkAllChanged();
+    }
+    else
+    {
+      MarkChanged(unlock_data.changed_range.GetBegin(), unlock_data.changed_range.GetEnd());
+    }
+  }
+  else
+  {
+    // Commit modified chunks
+    tBuffer& buffer = GetWritableCurrentBuffer();
+    if (unlock_data.buffer_size != tLockedBufferData<tBuffer>::cUNCHANGED_BUFFER_SIZE && unlock_data.buffer_size != buffer.size())
+    {
+      // Resized by remote writer that only committed changed elements
+      MarkChanged(std::min(buffer.size(), unlock_data.buffer_size), std::max(buffer.size(), unlock_data.buffer_size));
+      rrlib::rtti::ResizeVector(buffer, unlock_data.buffer_size);
+    }
+    for (auto & chunk : unlock_data.modified_chunks)
+    {
+      size_t end = std::min(buffer.size(), chunk.offset + chunk.elements.size());
+      if (chunk.offset < end)
+      {
+        tElementOperations<T>::Move(chunk.elements, 0, buffer, chunk.offset, end - chunk.offset);
+      }
+      MarkChanged(chunk.offset, end);
     }
-    std::swap(*unlock_data.buffer, current_buffer->GetObject().GetData<tBuffer>());
+    this->Statistics().committed_chunks += unlock_data.modified_chunks.size();
+
+    // Apply any pending changes
+    this->ApplyPendingChangeTasks(buffer);
   }
 
   // publish buffer
@@ -229,39 +375,165 @@ void tBlackboardServer<T>::HandleResponse(tLockedBufferData<tBuffer> unlock_data
 
   // Any pending lock requests?
   this->ProcessPendingLockRequests();
+  UpdateLockFreeReadBuffer();
+}
+
+template <typename T>
+void tBlackboardServer<T>::HandleRangeUnlock(tRangeLock& lock, tLockedBufferData<tBuffer>* unlock_data)
+{
+  rrlib::thread::tLock mutex_lock(this->BlackboardMutex());
+  if (lock.lock_id == 0 || (unlock_data && unlock_data->lock_id != lock.lock_id))
+  {
+    FINROC_LOG_PRINT(DEBUG, "Skipping outdated unlock");
+    return;
+  }
+  this->RetractLockFreeReadBuffer();
+
+  // Merge changes to locked range into current buffer
+  bool changed = unlock_data && (unlock_data->buffer || unlock_data->modified_chunks.size());
+  if (changed)
+  {
+    tBuffer& buffer = GetWritableCurrentBuffer();
+    size_t begin = std::max(lock.begin, unlock_data->changed_range.GetBegin());
+    size_t end = std::min(std::min(lock.end, buffer.size()), unlock_data->changed_range.GetEnd());
+    if (unlock_data->buffer)
+    {
+      tBuffer& committed_buffer = *unlock_data->buffer;
+      end = std::min(end, committed_buffer.size());
+      if (begin < end)
+      {
+        tElementOperations<T>::Move(committed_buffer, begin, buffer, begin, end - begin);
+      }
+      MarkChanged(begin, end);
+    }
+    else
+    {
+      for (auto & chunk : unlock_data->modified_chunks)
+      {
+        size_t chunk_begin = std::max(begin, chunk.offset);
+        size_t chunk_end = std::min(end, chunk.offset + chunk.elements.size());
+        if (chunk_begin < chunk_end)
+        {
+          tElementOperations<T>::Move(chunk.elements, chunk_begin - chunk.offset, buffer, chunk_begin, chunk_end - chunk_begin);
+        }
+        MarkChanged(chunk_begin, chunk_end);
+      }
+      this->Statistics().committed_chunks += unlock_data->modified_chunks.size();
+    }
+  }
+  ReleaseRangeLock(lock);
+  if (changed)
+  {
+    ConsiderPublishing();
+  }
+
+  // Apply changes that were deferred while ranges were locked
+  if (active_range_locks == 0 && pending_change_tasks.size() > 0)
+  {
+    ApplyPendingChangeTasksToCurrentBuffer();
+  }
+
+  // Any pending lock requests?
+  this->ProcessPendingLockRequests();
+  UpdateLockFreeReadBuffer();
 }
 
 template <typename T>
 void tBlackboardServer<T>::ProcessPendingLockRequests()
 {
-  while (pending_lock_requests.size() > 0)
+  RemoveExpiredLockRequests();
+  if (write_lock == tWriteLock::EXCLUSIVE)
   {
-    tLockRequest& lock_request = pending_lock_requests.front();
-    if (rrlib::time::Now() <= lock_request.timeout_time)
+    return;
+  }
+
+  // Grant all pending read locks
+  for (auto it = pending_lock_requests.begin(); it != pending_lock_requests.end();)
+  {
+    if (it->write_lock)
+    {
+      ++it;
+      continue;
+    }
+    if (it->read_delta)
+    {
+      it->read_delta_promise.SetValue(CreateReadDelta(it->known_revision));
+      it = pending_lock_requests.erase(it);
+      continue;
+    }
+    current_buffer->AddLocks(1);
+    tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()), *read_port.GetWrapped());
+    it->read_lock_promise.SetValue(pointer_clone);
+    it = pending_lock_requests.erase(it);
+  }
+
+  // Grant pending write locks in order of urgency (a write lock on the whole blackboard blocks less urgent requests for range locks)
+  for (auto it = pending_lock_requests.begin(); it != pending_lock_requests.end() && write_lock == tWriteLock::NONE;)
+  {
+    if (it->IsRangeLock())
     {
-      if (lock_request.write_lock)
+      if (RangeUnlocked(it->range_begin, it->range_end))
       {
-        WriteLockImplementation(lock_request.write_lock_promise, lock_request.remote_call);
-        pending_lock_requests.pop_front();
-        return;
+        RangeWriteLockImplementation(it->write_lock_promise, it->remote_call, it->range_begin, it->range_end);
+        it = pending_lock_requests.erase(it);
       }
       else
       {
-        current_buffer->AddLocks(1);
-        tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()), *read_port.GetWrapped());
-        lock_request.read_lock_promise.SetValue(pointer_clone);
+        ++it;
       }
     }
-    pending_lock_requests.pop_front();
+    else
+    {
+      if (active_range_locks == 0)
+      {
+        WriteLockImplementation(it->write_lock_promise, it->remote_call);
+        pending_lock_requests.erase(it);
+      }
+      return;
+    }
   }
 }
 
+template <typename T>
+bool tBlackboardServer<T>::ReadCopy(tBuffer& target, uint64_t& revision)
+{
+  if (!tSupportsSeqlockReads<T>::value)
+  {
+    return false;
+  }
+  if (!seqlock_buffer.Read(target, revision))
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    if (!seqlock_buffer.IsEnabled())
+    {
+      if (write_lock == tWriteLock::EXCLUSIVE)
+      {
+        return false;
+      }
+      seqlock_buffer.Update(current_buffer->GetObject().template GetData<tBuffer>(), tChangedRange::Complete(), content_revision);
+    }
+  }
+  return seqlock_buffer.Read(target, revision);
+}
+
 template <typename T>
 rpc_ports::tFuture<typename tBlackboardServer<T>::tConstBufferPointer> tBlackboardServer<T>::ReadLock(const rrlib::time::tDuration& timeout)
 {
-  rrlib::thread::tLock lock(this->BlackboardMutex());
   rpc_ports::tPromise<tConstBufferPointer> promise;
   rpc_ports::tFuture<tConstBufferPointer> future = promise.GetFuture();
+  this->RecordReadLock();
+
+  // Fast path: lock published buffer without acquiring mutex
+  data_ports::standard::tPortBufferManager* lock_free_buffer = this->TryLockFreeReadLock();
+  if (lock_free_buffer)
+  {
+    tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(lock_free_buffer), *read_port.GetWrapped());
+    promise.SetValue(pointer_clone);
+    return future;
+  }
+
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
   if (write_lock != tWriteLock::EXCLUSIVE)
   {
     assert(!current_buffer->IsUnused());
@@ -271,31 +543,356 @@ rpc_ports::tFuture<typename tBlackboardServer<T>::tConstBufferPointer> tBlackboa
   }
   else
   {
-    FINROC_LOG_PRINT(DEBUG, "Attempt to read-lock during exclusive write lock. Enabling multi-buffered mode to avoid blocking in such situations in the future.");
-    single_buffered = false;
+    FINROC_LOG_PRINT(DEBUG, "Attempt to read-lock during exclusive write lock.");
+    this->RecordReadCollision();
+    RemoveExpiredLockRequests();
+    if (timeout > rrlib::time::tDuration::zero())
+    {
+      EnqueueLockRequest(tLockRequest(std::move(promise), rrlib::time::Now() + timeout));
+    }
+  }
+  return future;
+}
+
+template <typename T>
+rpc_ports::tFuture<typename tBlackboardServer<T>::tDelta> tBlackboardServer<T>::ReadDelta(uint64_t known_revision, const rrlib::time::tDuration& timeout)
+{
+  rpc_ports::tPromise<tDelta> promise;
+  rpc_ports::tFuture<tDelta> future = promise.GetFuture();
+  this->RecordReadLock();
+
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
+  if (write_lock != tWriteLock::EXCLUSIVE)
+  {
+    promise.SetValue(CreateReadDelta(known_revision));
+  }
+  else
+  {
+    FINROC_LOG_PRINT(DEBUG, "Attempt to read delta during exclusive write lock.");
+    this->RecordReadCollision();
+    RemoveExpiredLockRequests();
     if (timeout > rrlib::time::tDuration::zero())
     {
-      this->pending_lock_requests.emplace_back(std::move(promise), rrlib::time::Now() + timeout);
+      EnqueueLockRequest(tLockRequest(std::move(promise), known_revision, rrlib::time::Now() + timeout));
+    }
+  }
+  return future;
+}
+
+template <typename T>
+rpc_ports::tFuture<typename tBlackboardServer<T>::tConstBufferPointer> tBlackboardServer<T>::ReadLockAtRevision(uint64_t revision)
+{
+  rpc_ports::tPromise<tConstBufferPointer> promise;
+  rpc_ports::tFuture<tConstBufferPointer> future = promise.GetFuture();
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  PruneRetainedRevisions();
+  for (auto & retained : retained_revisions)
+  {
+    if (retained.revision == revision)
+    {
+      retained.buffer->AddLocks(1);
+      tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(retained.buffer.get()), *read_port.GetWrapped());
+      promise.SetValue(pointer_clone);
+      return future;
     }
   }
+  promise.SetValue(tConstBufferPointer());
+  return future;
+}
+
+template <typename T>
+rpc_ports::tFuture<typename tBlackboardServer<T>::tConstBufferPointer> tBlackboardServer<T>::ReadLockAtTime(rrlib::time::tTimestamp timestamp)
+{
+  rpc_ports::tPromise<tConstBufferPointer> promise;
+  rpc_ports::tFuture<tConstBufferPointer> future = promise.GetFuture();
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  PruneRetainedRevisions();
+  for (auto it = retained_revisions.rbegin(); it != retained_revisions.rend(); ++it)
+  {
+    if (it->publish_time <= timestamp)
+    {
+      it->buffer->AddLocks(1);
+      tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(it->buffer.get()), *read_port.GetWrapped());
+      promise.SetValue(pointer_clone);
+      return future;
+    }
+  }
+  promise.SetValue(tConstBufferPointer());
+  return future;
+}
+
+template <typename T>
+void tBlackboardServer<T>::ProcessDeadlines()
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
+  RemoveExpiredLockRequests();
+  if (publish_pending && write_lock != tWriteLock::EXCLUSIVE && rrlib::time::Now() >= publish_due_time)
+  {
+    PublishCurrentBuffer();
+  }
+  ScheduleNextDeadline();
+}
+
+template <typename T>
+void tBlackboardServer<T>::PublishPendingChanges()
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  if (publish_pending && write_lock != tWriteLock::EXCLUSIVE)
+  {
+    PublishCurrentBuffer();
+  }
+}
+
+template <typename T>
+void tBlackboardServer<T>::RequestDeltaKeyframe()
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  if (delta_keyframe_interval)
+  {
+    delta_keyframe_requested = true;
+    if (write_lock != tWriteLock::EXCLUSIVE)
+    {
+      PublishDelta(true);
+    }
+  }
+}
+
+template <typename T>
+void tBlackboardServer<T>::RangeWriteLock(rpc_ports::tPromise<tLockedBuffer<tBuffer>>& promise, const tLockParameters& lock_parameters, size_t begin, size_t end)
+{
+  if (begin >= end)
+  {
+    FINROC_LOG_PRINT(WARNING, "Invalid range requested for write lock (", begin, " to ", end, ")");
+    return;
+  }
+  if (write_lock == tWriteLock::NONE && RangeUnlocked(begin, end) && (!HasPendingWriteLockRequest()))
+  {
+    RangeWriteLockImplementation(promise, lock_parameters.IsRemoteCall(), begin, end);
+  }
+  else
+  {
+    RemoveExpiredLockRequests();
+    if (lock_parameters.GetTimeout() > rrlib::time::tDuration::zero())
+    {
+      EnqueueLockRequest(tLockRequest(std::move(promise), rrlib::time::Now() + lock_parameters.GetTimeout(), lock_parameters.IsRemoteCall(), lock_parameters.GetPriority(),
+                                      begin, end));
+    }
+  }
+}
+
+template <typename T>
+void tBlackboardServer<T>::RangeWriteLockImplementation(rpc_ports::tPromise<tLockedBuffer<tBuffer>>& promise, bool remote_call, size_t begin, size_t end)
+{
+  assert(!current_buffer->IsUnused());
+  tRangeLock* range_lock = NULL;
+  for (auto & lock : range_locks)
+  {
+    if (!lock->lock_id)
+    {
+      range_lock = lock.get();
+      break;
+    }
+  }
+  if (!range_lock)
+  {
+    range_locks.emplace_back(new tRangeLock(*this));
+    range_lock = range_locks.back().get();
+  }
+  lock_id++;
+  range_lock->lock_id = lock_id;
+  range_lock->lease_expiry_time = LeaseExpiryTime(remote_call);
+  range_lock->begin = begin;
+  range_lock->end = end;
+  active_range_locks++;
+
+  // Range locks always operate on copies of the locked elements
+  current_buffer->AddLocks(1);
+  tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()), *read_port.GetWrapped());
+  tLockedBuffer<tBuffer> locked_buffer(std::move(pointer_clone), lock_id);
+  locked_buffer.SetBufferSource(read_port);
+  locked_buffer.SetWritableRange(begin, end);
+  locked_buffer.SetCompression(compression);
+  if (!remote_call)
+  {
+    locked_buffer.SetChunkedCopyOnWrite(chunk_size ? chunk_size : (end - begin));
+  }
+  range_lock->unlock_future = locked_buffer.GetFuture();
+  range_lock->unlock_future.SetCallback(*range_lock);
+  promise.SetValue(locked_buffer);
+  if (range_lock->lease_expiry_time != rrlib::time::cNO_TIME)
+  {
+    ScheduleNextDeadline();  // revoke lock when lease expires
+  }
+}
+
+template <typename T>
+void tBlackboardServer<T>::SetRevisionRetention(size_t max_revisions, const rrlib::time::tDuration& max_age)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  max_retained_revisions = max_revisions;
+  max_retention_age = max_age;
+  PruneRetainedRevisions();
+}
+
+template <typename T>
+void tBlackboardServer<T>::SetShardCount(size_t shard_count)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  this->shard_count = std::max<size_t>(1, shard_count);
+}
+
+template <typename T>
+rpc_ports::tFuture<tLockedBuffer<typename tBlackboardServer<T>::tBuffer>> tBlackboardServer<T>::ShardWriteLock(tLockParameters lock_parameters, uint32_t first_shard, uint32_t shard_count)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
+  rpc_ports::tPromise<tLockedBuffer<tBuffer>> promise;
+  rpc_ports::tFuture<tLockedBuffer<tBuffer>> future = promise.GetFuture();
+  size_t end_shard = static_cast<size_t>(first_shard) + shard_count;
+  if (shard_count == 0 || end_shard > this->shard_count)
+  {
+    FINROC_LOG_PRINT(WARNING, "Invalid shard range requested (", first_shard, " to ", end_shard, "; shard count is ", this->shard_count, ")");
+    return future;
+  }
+  size_t shard_size = ShardSize();
+  RangeWriteLock(promise, lock_parameters, first_shard * shard_size, end_shard * shard_size);
   return future;
 }
 
+template <typename T>
+void tBlackboardServer<T>::RenewLockLease(uint64_t lock_id)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
+  if (write_lock != tWriteLock::NONE && lock_id == this->lock_id && lease_expiry_time != rrlib::time::cNO_TIME)
+  {
+    lease_expiry_time = LeaseExpiryTime(true);
+  }
+  for (auto & range_lock : range_locks)
+  {
+    if (range_lock->lock_id == lock_id && range_lock->lease_expiry_time != rrlib::time::cNO_TIME)
+    {
+      range_lock->lease_expiry_time = LeaseExpiryTime(true);
+    }
+  }
+}
+
+template <typename T>
+void tBlackboardServer<T>::RevokeExpiredLockLeases()
+{
+  if (lock_lease_duration == rrlib::time::tDuration::zero())
+  {
+    return;
+  }
+  rrlib::time::tTimestamp now = rrlib::time::Now();
+  if (write_lock != tWriteLock::NONE && lease_expiry_time != rrlib::time::cNO_TIME && now >= lease_expiry_time)
+  {
+    FINROC_LOG_PRINT(WARNING, "Lease of remote write lock expired. Revoking lock.");
+    this->Statistics().expired_lock_leases++;
+    ReleaseWriteLock();
+  }
+
+  bool range_lock_revoked = false;
+  for (auto & range_lock : range_locks)
+  {
+    if (range_lock->lock_id && range_lock->lease_expiry_time != rrlib::time::cNO_TIME && now >= range_lock->lease_expiry_time)
+    {
+      FINROC_LOG_PRINT(WARNING, "Lease of remote write lock on range expired. Revoking lock.");
+      this->Statistics().expired_lock_leases++;
+      ReleaseRangeLock(*range_lock);
+      range_lock_revoked = true;
+    }
+  }
+  if (range_lock_revoked)
+  {
+    this->RetractLockFreeReadBuffer();
+
+    // Apply changes that were deferred while ranges were locked
+    if (active_range_locks == 0 && pending_change_tasks.size() > 0)
+    {
+      ApplyPendingChangeTasksToCurrentBuffer();
+    }
+    this->ProcessPendingLockRequests();
+    UpdateLockFreeReadBuffer();
+  }
+}
+
+template <typename T>
+void tBlackboardServer<T>::SetChunkedCopyOnWrite(size_t chunk_size)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  this->chunk_size = chunk_size;
+  buffer_factory.Recycle(std::move(spare_buffer));
+  spare_outdated_chunks.clear();
+  spare_outdated_completely = true;
+}
+
+template <typename T>
+void tBlackboardServer<T>::SetDeltaPublishing(size_t keyframe_interval)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  if (keyframe_interval && (!delta_port.GetWrapped()))
+  {
+    delta_port = data_ports::tOutputPort<tDelta>("read delta", this, core::tFrameworkElement::tFlag::FINSTRUCT_READ_ONLY | GenerateConstructorFlags(shared));
+    if (this->IsReady())
+    {
+      delta_port.Init();
+    }
+  }
+  delta_keyframe_interval = keyframe_interval;
+  delta_keyframe_requested = true;
+}
+
+template <typename T>
+void tBlackboardServer<T>::SetPublishingPolicy(tPublishingPolicy policy, const rrlib::time::tDuration& min_interval)
+{
+  rrlib::thread::tLock lock(this->BlackboardMutex());
+  publishing_policy = policy;
+  min_publish_interval = min_interval;
+  if (policy == tPublishingPolicy::PERIODIC)
+  {
+    last_publish_time = rrlib::time::Now();
+  }
+  if (publish_pending)
+  {
+    if (policy == tPublishingPolicy::IMMEDIATE || min_interval == rrlib::time::tDuration::zero())
+    {
+      if (write_lock != tWriteLock::EXCLUSIVE)
+      {
+        PublishCurrentBuffer();
+      }
+    }
+    else
+    {
+      publish_due_time = ComputePublishDueTime(rrlib::time::Now());
+      ScheduleNextDeadline();
+    }
+  }
+}
+
 template <typename T>
 rpc_ports::tFuture<tLockedBuffer<typename tBlackboardServer<T>::tBuffer>> tBlackboardServer<T>::WriteLock(tLockParameters lock_parameters)
 {
   rrlib::thread::tLock lock(this->BlackboardMutex());
+  RevokeExpiredLockLeases();
   rpc_ports::tPromise<tLockedBuffer<tBuffer>> promise;
   rpc_ports::tFuture<tLockedBuffer<tBuffer>> future = promise.GetFuture();
-  if (write_lock == tWriteLock::NONE)
+  if (lock_parameters.IsRangeLock())
+  {
+    RangeWriteLock(promise, lock_parameters, lock_parameters.GetRangeBegin(), lock_parameters.GetRangeEnd());
+  }
+  else if (write_lock == tWriteLock::NONE && active_range_locks == 0)
   {
     WriteLockImplementation(promise, lock_parameters.IsRemoteCall());
   }
   else
   {
+    RemoveExpiredLockRequests();
     if (lock_parameters.GetTimeout() > rrlib::time::tDuration::zero())
     {
-      this->pending_lock_requests.emplace_back(std::move(promise), rrlib::time::Now() + lock_parameters.GetTimeout(), lock_parameters.IsRemoteCall());
+      EnqueueLockRequest(tLockRequest(std::move(promise), rrlib::time::Now() + lock_parameters.GetTimeout(), lock_parameters.IsRemoteCall(), lock_parameters.GetPriority()));
     }
   }
   return future;
@@ -305,7 +902,33 @@ template <typename T>
 void tBlackboardServer<T>::WriteLockImplementation(rpc_ports::tPromise<tLockedBuffer<tBuffer>>& promise, bool remote_call)
 {
   assert(!current_buffer->IsUnused());
-  if ((!remote_call) && current_buffer->Unique())
+  lease_expiry_time = LeaseExpiryTime(remote_call);
+  if (!remote_call)
+  {
+    this->RetractLockFreeReadBuffer(); // lock-free read locks must not add locks after uniqueness check below
+    this->RecordWriteLock();
+  }
+  if ((!remote_call) && this->BufferMode() == tBufferMode::TRIPLE_BUFFERED)
+  {
+    tTripleBufferSpare* back_buffer = ObtainTripleBufferSpare(true);
+    if (back_buffer)
+    {
+      // Readers continue to use current buffer - writer modifies back buffer in-place
+      write_lock = tWriteLock::ON_COPY;
+      lock_id++;
+      triple_back_buffer = &back_buffer->buffer->GetObject().template GetData<tBuffer>();
+      back_buffer->buffer->AddLocks(1);
+      tBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(back_buffer->buffer.get()), *read_port.GetWrapped());
+      tLockedBuffer<tBuffer> locked_buffer(std::move(pointer_clone), lock_id);
+      locked_buffer.SetBufferSource(read_port);
+      unlock_future = locked_buffer.GetFuture();
+      unlock_future.SetCallback(*this);
+      promise.SetValue(locked_buffer);
+      UpdateLockFreeReadBuffer();
+      return;
+    }
+  }
+  if ((!remote_call) && this->BufferMode() == tBufferMode::SINGLE_BUFFERED && current_buffer->Unique())
   {
     write_lock = tWriteLock::EXCLUSIVE;
     lock_id++;
@@ -325,9 +948,19 @@ void tBlackboardServer<T>::WriteLockImplementation(rpc_ports::tPromise<tLockedBu
     tConstBufferPointer pointer_clone(data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()), *read_port.GetWrapped());
     tLockedBuffer<tBuffer> locked_buffer(std::move(pointer_clone), lock_id);
     locked_buffer.SetBufferSource(read_port);
+    locked_buffer.SetCompression(compression);  // remote writers receive complete content - only commits are reduced to changed elements
+    if (!remote_call)
+    {
+      locked_buffer.SetChunkedCopyOnWrite(chunk_size);
+    }
     unlock_future = locked_buffer.GetFuture();
     unlock_future.SetCallback(*this);
     promise.SetValue(locked_buffer);
+    UpdateLockFreeReadBuffer();
+    if (lease_expiry_time != rrlib::time::cNO_TIME)
+    {
+      ScheduleNextDeadline();  // revoke lock when lease expires
+    }
   }
 }
 
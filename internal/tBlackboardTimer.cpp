@@ -0,0 +1,172 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tBlackboardTimer.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tBlackboardTimer.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tAbstractBlackboardServer.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Maximum time that timer thread waits without checking its stop signal */
+static const rrlib::time::tDuration cMAX_WAIT_DURATION = std::chrono::milliseconds(100);
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+tBlackboardTimer::tBlackboardTimer() :
+  rrlib::thread::tThread(std::string("Blackboard Timer")),
+  mutex(),
+  deadlines_changed(mutex),
+  deadlines(),
+  processed_server(NULL)
+{
+}
+
+void tBlackboardTimer::Cancel(tAbstractBlackboardServer& server)
+{
+  tBlackboardTimer* timer = GetInstance(false);
+  if (!timer)
+  {
+    return;  // no deadline was ever scheduled (Schedule() calls from now on see that server is being deleted)
+  }
+  rrlib::thread::tLock lock(timer->mutex);
+  while (timer->processed_server == &server)
+  {
+    timer->deadlines_changed.Wait(lock, cMAX_WAIT_DURATION, false);
+  }
+  timer->deadlines.erase(&server);  // also removes deadline that might have been scheduled while processing
+}
+
+tBlackboardTimer* tBlackboardTimer::GetInstance(bool create)
+{
+  // Thread is never deleted, as blackboard servers may be deleted during static destruction
+  static tBlackboardTimer* instance = nullptr;
+  static rrlib::thread::tMutex instance_mutex;
+  rrlib::thread::tLock lock(instance_mutex);
+  if ((!instance) && create)
+  {
+    instance = new tBlackboardTimer();
+    instance->Start();
+  }
+  return instance;
+}
+
+void tBlackboardTimer::Run()
+{
+  while (!GetStopSignal())
+  {
+    tAbstractBlackboardServer* due_server = NULL;
+    {
+      rrlib::thread::tLock lock(mutex);
+      if (processed_server)
+      {
+        processed_server = NULL;
+        deadlines_changed.NotifyAll();  // Cancel() might be waiting
+      }
+
+      auto next = deadlines.end();
+      for (auto it = deadlines.begin(); it != deadlines.end(); ++it)
+      {
+        if (next == deadlines.end() || it->second < next->second)
+        {
+          next = it;
+        }
+      }
+      rrlib::time::tTimestamp now = rrlib::time::Now();
+      if (next != deadlines.end() && next->second <= now)
+      {
+        due_server = next->first;
+        processed_server = due_server;
+        deadlines.erase(next);
+      }
+      else
+      {
+        rrlib::time::tDuration wait_duration = next != deadlines.end() ? std::min(cMAX_WAIT_DURATION, next->second - now) : cMAX_WAIT_DURATION;
+        deadlines_changed.Wait(lock, wait_duration, true, now);
+      }
+    }
+
+    if (due_server)
+    {
+      due_server->ProcessDeadlines();
+    }
+  }
+}
+
+void tBlackboardTimer::Schedule(tAbstractBlackboardServer& server, const rrlib::time::tTimestamp& deadline)
+{
+  tBlackboardTimer& timer = *GetInstance(true);
+  rrlib::thread::tLock lock(timer.mutex);
+  if (server.deleting)
+  {
+    return;  // checked while holding timer mutex: Cancel() might have completed already
+  }
+  timer.deadlines[&server] = deadline;
+  timer.deadlines_changed.NotifyAll();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
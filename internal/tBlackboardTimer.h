@@ -0,0 +1,142 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tBlackboardTimer.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tBlackboardTimer
+ *
+ * \b tBlackboardTimer
+ *
+ * Thread shared by all blackboard servers in a process that processes
+ * time-based server tasks when they are due (e.g. publishing changes
+ * deferred by the publishing policy).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tBlackboardTimer_h__
+#define __plugins__blackboard__internal__tBlackboardTimer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/thread/tThread.h"
+#include "rrlib/thread/tConditionVariable.h"
+#include <map>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+class tAbstractBlackboardServer;
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Timer for blackboard servers
+/*!
+ * Thread shared by all blackboard servers in a process.
+ * Calls tAbstractBlackboardServer::ProcessDeadlines() when a server's scheduled deadline is due.
+ * Each server has at most one scheduled deadline.
+ * ProcessDeadlines() is called without holding the timer's mutex - so servers may schedule
+ * their next deadline from there (and generally while holding their blackboard mutex).
+ */
+class tBlackboardTimer : public rrlib::thread::tThread
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Cancels deadline of blackboard server.
+   * If the timer is currently processing deadlines of this server, waits until it has completed.
+   * Server must be marked as being deleted before (deadlines scheduled afterwards are ignored).
+   * (must not be called while holding the server's blackboard mutex)
+   *
+   * \param server Blackboard server
+   */
+  static void Cancel(tAbstractBlackboardServer& server);
+
+  /*!
+   * Schedules call to ProcessDeadlines() of blackboard server
+   * (replaces any deadline of this server scheduled before; ignored if server is being deleted)
+   *
+   * \param server Blackboard server
+   * \param deadline Time when ProcessDeadlines() is to be called
+   */
+  static void Schedule(tAbstractBlackboardServer& server, const rrlib::time::tTimestamp& deadline);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Mutex for timer operations */
+  rrlib::thread::tMutex mutex;
+
+  /*! Notified whenever deadlines change or processing deadlines of a server has completed */
+  rrlib::thread::tConditionVariable deadlines_changed;
+
+  /*! Scheduled deadline for every blackboard server */
+  std::map<tAbstractBlackboardServer*, rrlib::time::tTimestamp> deadlines;
+
+  /*! Blackboard server whose deadlines are currently processed (NULL if none) */
+  tAbstractBlackboardServer* processed_server;
+
+
+  tBlackboardTimer();
+
+  /*!
+   * \param create Create and start timer if it does not exist yet?
+   * \return Timer instance (NULL if it does not exist and 'create' is false)
+   */
+  static tBlackboardTimer* GetInstance(bool create);
+
+  virtual void Run() override;
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
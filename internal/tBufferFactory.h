@@ -0,0 +1,203 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tBufferFactory.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tBufferFactory
+ *
+ * \b tBufferFactory
+ *
+ * Provides buffers for new blackboard content.
+ * Buffers that a blackboard server replaced are kept in a small per-server
+ * free list. As soon as no one else holds a lock on such a buffer anymore,
+ * it is reused for new content - retaining its capacity (and the heap memory
+ * of its elements). In steady state, no heap allocation should occur when
+ * new blackboard content is created.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tBufferFactory_h__
+#define __plugins__blackboard__internal__tBufferFactory_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <deque>
+#include "plugins/data_ports/tOutputPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tAbstractBlackboardServer.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Factory for blackboard buffers
+/*!
+ * Provides buffers for new blackboard content.
+ * Buffers replaced by the owner are kept in a free list and reused
+ * once they are no longer locked by anyone else. Only if no such buffer
+ * with sufficient capacity is available, a buffer is obtained from the port's pool.
+ *
+ * \tparam T Type of blackboard elements
+ */
+template <typename T>
+class tBufferFactory : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::vector<T> tBuffer;
+  typedef typename data_ports::standard::tStandardPort::tLockingManagerPointer tBufferManagerPointer;
+
+  /*!
+   * \param statistics Statistics to record buffer reuse in
+   */
+  tBufferFactory(tAbstractBlackboardServer::tStatistics& statistics) :
+    statistics(statistics),
+    free_buffers()
+  {}
+
+  /*!
+   * Releases all buffers kept for reuse
+   * (must be called before port that buffers were obtained from is deleted)
+   */
+  void Clear()
+  {
+    free_buffers.clear();
+  }
+
+  /*!
+   * Obtains buffer for new blackboard content
+   * (may only be called in synchronized context)
+   *
+   * \param port Port whose buffer pool to obtain buffer from if no retired buffer can be reused
+   * \param copy_source If not NULL, buffer content is copied from this buffer
+   * \return Buffer with reference counter set to one
+   */
+  tBufferManagerPointer GetBuffer(data_ports::standard::tStandardPort& port, const tBuffer* copy_source)
+  {
+    // Reuse unlocked retired buffer with smallest sufficient capacity
+    size_t required_capacity = copy_source ? copy_source->size() : 0;
+    auto best_fit = free_buffers.end();
+    for (auto it = free_buffers.begin(); it != free_buffers.end(); ++it)
+    {
+      size_t capacity = GetData(*it).capacity();
+      if ((*it)->Unique() && capacity >= required_capacity && (best_fit == free_buffers.end() || capacity < GetData(*best_fit).capacity()))
+      {
+        best_fit = it;
+      }
+    }
+
+    tBufferManagerPointer buffer;
+    if (best_fit != free_buffers.end())
+    {
+      buffer = std::move(*best_fit);
+      free_buffers.erase(best_fit);
+      statistics.buffer_reuse_hits++;
+    }
+    else
+    {
+      typename data_ports::standard::tStandardPort::tUnusedManagerPointer unused_buffer = port.GetUnusedBufferRaw();
+      unused_buffer->SetUnused(false);
+      unused_buffer->InitReferenceCounter(1);
+      buffer.reset(unused_buffer.release());
+      statistics.buffer_reuse_misses++;
+    }
+    if (copy_source)
+    {
+      rrlib::rtti::GenericOperations<tBuffer>::DeepCopy(*copy_source, GetData(buffer));
+    }
+    return buffer;
+  }
+
+  /*!
+   * Retires buffer that no longer contains current content.
+   * It is reused by GetBuffer() as soon as no one else holds a lock on it.
+   * (may only be called in synchronized context)
+   *
+   * \param buffer Buffer to retire (lock is taken over - may be NULL)
+   */
+  void Recycle(tBufferManagerPointer && buffer)
+  {
+    if (!buffer)
+    {
+      return;
+    }
+    if (free_buffers.size() >= cMAX_FREE_BUFFERS)
+    {
+      free_buffers.pop_front();  // oldest buffer is returned to port's pool
+    }
+    free_buffers.push_back(std::move(buffer));
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Maximum number of retired buffers kept for reuse */
+  static const size_t cMAX_FREE_BUFFERS = 4;
+
+  /*! Statistics to record buffer reuse in */
+  tAbstractBlackboardServer::tStatistics& statistics;
+
+  /*! Retired buffers (oldest first) - server holds one lock on each */
+  std::deque<tBufferManagerPointer> free_buffers;
+
+
+  static tBuffer& GetData(tBufferManagerPointer& buffer)
+  {
+    return buffer->GetObject().template GetData<tBuffer>();
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,336 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tChangeSetCodec.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tChangeSetCodec
+ *
+ * \b tChangeSetCodec
+ *
+ * Compact serialization of change sets.
+ * Single-element replace changes are sorted by index. Changes to adjacent indices
+ * are collapsed into runs - and each run is written as one record
+ * (start index as varint delta to the previous run, varint element count, new elements).
+ * Other changes (including empty changes) are written one by one.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tChangeSetCodec_h__
+#define __plugins__blackboard__internal__tChangeSetCodec_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+
+template <typename T>
+class tChange;
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Compact serialization of change sets
+/*!
+ * Compact serialization of change sets.
+ *
+ * A change set is written as a sequence of blocks. Each maximal sequence of
+ * single-element replace changes forms one block. All other changes (e.g. range changes
+ * and empty changes) are written one by one, so that their order relative to other changes is retained.
+ *
+ * Within a block, changes are sorted by index (stable - so that changes to the same element keep their order).
+ * Changes to adjacent indices are collapsed into runs. Each run is written as one record:
+ * start index as varint delta to the last index of the previous run, varint number of changes,
+ * and the new elements.
+ * As every change occupies at least one byte in the stream, the deserializer only allocates
+ * storage for changes as they are decoded (the change count in the stream is not trusted).
+ * The order of changes to different elements is not retained within a block, as it does not affect the result of applying a change set.
+ *
+ * \tparam T Type of blackboard elements
+ */
+template <typename T>
+class tChangeSetCodec
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::vector<tChange<T>> tChangeSet;
+
+  /*!
+   * Deserializes change set (storage of existing changes is reused)
+   *
+   * \param stream Stream to read from
+   * \param change_set Change set to deserialize to
+   * \throws Throws std::runtime_error if data is invalid
+   */
+  static void Deserialize(rrlib::serialization::tInputStream& stream, tChangeSet& change_set)
+  {
+    uint64_t change_count = ReadVarint(stream);
+    size_t change_index = 0;
+    while (change_index < change_count)
+    {
+      if (stream.ReadByte() == cREPLACE_BLOCK)
+      {
+        change_index += DeserializeReplaceBlock(stream, change_set, change_index, change_count - change_index);
+      }
+      else
+      {
+        ProvideStorage(change_set, change_index);
+        stream >> change_set[change_index];
+        change_index++;
+      }
+    }
+    if (change_set.size() != change_index)
+    {
+      rrlib::rtti::ResizeVector(change_set, change_index);
+    }
+  }
+
+  /*!
+   * Serializes change set
+   *
+   * \param stream Stream to write to
+   * \param change_set Change set to serialize
+   */
+  static void Serialize(rrlib::serialization::tOutputStream& stream, const tChangeSet& change_set)
+  {
+    WriteVarint(stream, change_set.size());
+    for (size_t block_begin = 0; block_begin < change_set.size();)
+    {
+      if (!IsReplaceBlockChange(change_set[block_begin]))
+      {
+        stream.WriteByte(cSINGLE_CHANGE);
+        stream << change_set[block_begin];
+        block_begin++;
+        continue;
+      }
+      size_t block_end = block_begin + 1;
+      while (block_end < change_set.size() && IsReplaceBlockChange(change_set[block_end]))
+      {
+        block_end++;
+      }
+      stream.WriteByte(cREPLACE_BLOCK);
+      SerializeReplaceBlock(stream, change_set.data() + block_begin, block_end - block_begin);
+      block_begin = block_end;
+    }
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Tags that precede blocks in serialized change sets */
+  enum { cREPLACE_BLOCK = 0, cSINGLE_CHANGE = 1 };
+
+  /*!
+   * Deserializes block of single-element replace changes
+   *
+   * \param stream Stream to read from
+   * \param change_set Change set to deserialize to
+   * \param first_change Index of first change of block in change set
+   * \param max_changes Maximum number of changes in block
+   * \return Number of changes in block
+   */
+  static size_t DeserializeReplaceBlock(rrlib::serialization::tInputStream& stream, tChangeSet& change_set, size_t first_change, uint64_t max_changes)
+  {
+    uint64_t change_count = ReadVarint(stream);
+    uint64_t record_count = ReadVarint(stream);
+    if (change_count == 0 || change_count > max_changes || record_count > change_count)
+    {
+      throw std::runtime_error("Invalid change set encoding");
+    }
+
+    uint64_t decoded_changes = 0;
+    uint64_t last_index = 0;
+    for (uint64_t i = 0; i < record_count; i++)
+    {
+      uint64_t start = last_index + ReadVarint(stream);
+      uint64_t count = ReadVarint(stream);
+      if (count == 0 || count > change_count - decoded_changes)
+      {
+        throw std::runtime_error("Invalid change set encoding");
+      }
+      for (uint64_t k = 0; k < count; k++, decoded_changes++)
+      {
+        size_t change_index = first_change + decoded_changes;
+        ProvideStorage(change_set, change_index);
+        tChange<T>& change = change_set[change_index];
+        change.index = static_cast<int>(start + k);
+        change.operation = tChangeOperation::REPLACE;
+        stream >> change.new_element;
+      }
+      last_index = start + count - 1;
+    }
+    if (decoded_changes != change_count)
+    {
+      throw std::runtime_error("Invalid change set encoding");
+    }
+    return change_count;
+  }
+
+  /*!
+   * \return Whether change is written as part of a block of single-element replace changes (empty changes are not)
+   */
+  static bool IsReplaceBlockChange(const tChange<T>& change)
+  {
+    return change.operation == tChangeOperation::REPLACE && change.GetIndex() >= 0;
+  }
+
+  /*!
+   * Makes sure that change set has storage for change with specified index
+   * (existing storage is reused)
+   *
+   * \param change_set Change set
+   * \param change_index Index of change
+   */
+  static void ProvideStorage(tChangeSet& change_set, size_t change_index)
+  {
+    if (change_set.size() <= change_index)
+    {
+      rrlib::rtti::ResizeVector(change_set, std::max<size_t>(change_index + 1, change_set.size() * 2));
+    }
+  }
+
+  /*!
+   * Reads unsigned integer in variable-length encoding (7 bits per byte, least significant first)
+   */
+  static uint64_t ReadVarint(rrlib::serialization::tInputStream& stream)
+  {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      uint8_t byte = static_cast<uint8_t>(stream.ReadByte());
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80))
+      {
+        return result;
+      }
+    }
+    throw std::runtime_error("Invalid varint in change set encoding");
+  }
+
+  /*!
+   * Serializes block of single-element replace changes
+   *
+   * \param stream Stream to write to
+   * \param changes Changes in block
+   * \param change_count Number of changes in block
+   */
+  static void SerializeReplaceBlock(rrlib::serialization::tOutputStream& stream, const tChange<T>* changes, size_t change_count)
+  {
+    std::vector<const tChange<T>*> sorted_changes;
+    sorted_changes.reserve(change_count);
+    bool sorted = true;
+    for (size_t i = 0; i < change_count; i++)
+    {
+      sorted &= sorted_changes.empty() || sorted_changes.back()->GetIndex() <= changes[i].GetIndex();
+      sorted_changes.push_back(&changes[i]);
+    }
+    if (!sorted)
+    {
+      std::stable_sort(sorted_changes.begin(), sorted_changes.end(), [](const tChange<T>* a, const tChange<T>* b)
+      {
+        return a->GetIndex() < b->GetIndex();
+      });
+    }
+
+    size_t record_count = 0;
+    for (size_t i = 0; i < sorted_changes.size(); i++)
+    {
+      if (i == 0 || sorted_changes[i]->GetIndex() != sorted_changes[i - 1]->GetIndex() + 1)
+      {
+        record_count++;
+      }
+    }
+
+    WriteVarint(stream, change_count);
+    WriteVarint(stream, record_count);
+    uint64_t last_index = 0;
+    for (size_t i = 0; i < sorted_changes.size();)
+    {
+      size_t count = 1;
+      while (i + count < sorted_changes.size() && sorted_changes[i + count]->GetIndex() == sorted_changes[i + count - 1]->GetIndex() + 1)
+      {
+        count++;
+      }
+      WriteVarint(stream, sorted_changes[i]->GetIndex() - last_index);
+      WriteVarint(stream, count);
+      for (size_t k = 0; k < count; k++)
+      {
+        stream << sorted_changes[i + k]->new_element;
+      }
+      last_index = sorted_changes[i + count - 1]->GetIndex();
+      i += count;
+    }
+  }
+
+  /*!
+   * Writes unsigned integer in variable-length encoding (7 bits per byte, least significant first)
+   */
+  static void WriteVarint(rrlib::serialization::tOutputStream& stream, uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      stream.WriteByte(static_cast<int8_t>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    stream.WriteByte(static_cast<int8_t>(value));
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
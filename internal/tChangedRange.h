@@ -0,0 +1,228 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tChangedRange.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tChangedRange
+ *
+ * \b tChangedRange
+ *
+ * Range of blackboard elements that were changed.
+ * Tracked by write accesses and by the blackboard server, so that
+ * consumers do not need to assume that the whole blackboard changed.
+ * Tracking is deliberately coarse (one bounding range) so that it
+ * costs hardly anything per element access.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tChangedRange_h__
+#define __plugins__blackboard__internal__tChangedRange_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Range of changed blackboard elements
+/*!
+ * Range of blackboard elements that were changed.
+ * Tracked by write accesses and by the blackboard server, so that
+ * consumers do not need to assume that the whole blackboard changed.
+ * Tracking is deliberately coarse (one bounding range) so that it
+ * costs hardly anything per element access.
+ */
+class tChangedRange
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Creates empty range */
+  tChangedRange() :
+    begin(std::numeric_limits<size_t>::max()),
+    end(0)
+  {}
+
+  /*!
+   * \return Range that covers all elements (changes are unknown)
+   */
+  static tChangedRange Complete()
+  {
+    tChangedRange result;
+    result.AddAll();
+    return result;
+  }
+
+  /*!
+   * \param index Index of changed element
+   */
+  inline void Add(size_t index)
+  {
+    if (index < begin)
+    {
+      begin = index;
+    }
+    if (index >= end)
+    {
+      end = index + 1;
+    }
+  }
+
+  /*!
+   * \param begin Index of first changed element
+   * \param end Index after last changed element
+   */
+  void Add(size_t begin, size_t end)
+  {
+    if (begin < end)
+    {
+      this->begin = std::min(this->begin, begin);
+      this->end = std::max(this->end, end);
+    }
+  }
+
+  /*!
+   * \param other Other range to include in this range
+   */
+  void Add(const tChangedRange& other)
+  {
+    Add(other.begin, other.end);
+  }
+
+  /*!
+   * Marks all elements as changed
+   */
+  void AddAll()
+  {
+    begin = 0;
+    end = std::numeric_limits<size_t>::max();
+  }
+
+  /*!
+   * Resets range to empty range
+   */
+  void Clear()
+  {
+    begin = std::numeric_limits<size_t>::max();
+    end = 0;
+  }
+
+  /*!
+   * \return Index of first changed element
+   */
+  size_t GetBegin() const
+  {
+    return begin;
+  }
+
+  /*!
+   * \return Index after last changed element (std::numeric_limits<size_t>::max() if all elements changed)
+   */
+  size_t GetEnd() const
+  {
+    return end;
+  }
+
+  /*!
+   * \return True if all elements are marked as changed
+   */
+  bool IsComplete() const
+  {
+    return begin == 0 && end == std::numeric_limits<size_t>::max();
+  }
+
+  /*!
+   * \return True if no element is marked as changed
+   */
+  bool IsEmpty() const
+  {
+    return begin >= end;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Index of first changed element */
+  size_t begin;
+
+  /*! Index after last changed element */
+  size_t end;
+};
+
+inline rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tChangedRange& range)
+{
+  stream << static_cast<uint64_t>(range.GetBegin()) << static_cast<uint64_t>(range.GetEnd());
+  return stream;
+}
+
+inline rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tChangedRange& range)
+{
+  uint64_t begin, end;
+  stream >> begin >> end;
+  range.Clear();
+  if (end == std::numeric_limits<uint64_t>::max())
+  {
+    range.Add(static_cast<size_t>(begin), std::numeric_limits<size_t>::max());
+  }
+  else
+  {
+    range.Add(static_cast<size_t>(begin), static_cast<size_t>(end));
+  }
+  return stream;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,266 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tCompressionCodec.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ */
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tCompressionCodec.h"
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+#include <stdexcept>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Minimum length of back-references in LZ codec */
+static const size_t cMIN_MATCH = 4;
+
+/*! Maximum distance of back-references in LZ codec */
+static const size_t cMAX_OFFSET = 65535;
+
+/*! Number of bits of hash values that are used to find back-references */
+static const int cHASH_BITS = 12;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+static void WriteVarint(std::vector<uint8_t>& output, size_t value)
+{
+  while (value >= 0x80)
+  {
+    output.push_back(static_cast<uint8_t>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<uint8_t>(value));
+}
+
+static size_t ReadVarint(const uint8_t* input, size_t size, size_t& position)
+{
+  size_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    if (position >= size)
+    {
+      throw std::runtime_error("Compressed blackboard data ends unexpectedly");
+    }
+    uint8_t byte = input[position++];
+    value |= static_cast<size_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return value;
+    }
+  }
+  throw std::runtime_error("Invalid varint in compressed blackboard data");
+}
+
+static inline uint32_t Hash(const uint8_t* data)
+{
+  uint32_t sequence;
+  memcpy(&sequence, data, sizeof(sequence));
+  return (sequence * 2654435761u) >> (32 - cHASH_BITS);
+}
+
+void tCompressionCodec::Compress(const uint8_t* input, size_t size, size_t element_size, tCompression compression, std::vector<uint8_t>& output)
+{
+  assert(compression != tCompression::NONE && element_size > 0 && size % element_size == 0);
+  output.clear();
+  if (compression == tCompression::SHUFFLE_DELTA_LZ)
+  {
+    std::vector<uint8_t> filtered(size);
+    ShuffleDelta(input, size, element_size, filtered.data());
+    LZCompress(filtered.data(), size, output);
+  }
+  else
+  {
+    LZCompress(input, size, output);
+  }
+}
+
+void tCompressionCodec::Decompress(const uint8_t* input, size_t size, size_t element_size, tCompression compression, uint8_t* output, size_t output_size)
+{
+  if (element_size == 0 || output_size % element_size != 0)
+  {
+    throw std::runtime_error("Invalid size of compressed blackboard data");
+  }
+  switch (compression)
+  {
+  case tCompression::LZ:
+    LZDecompress(input, size, output, output_size);
+    break;
+  case tCompression::SHUFFLE_DELTA_LZ:
+  {
+    std::vector<uint8_t> filtered(output_size);
+    LZDecompress(input, size, filtered.data(), output_size);
+    UnshuffleDelta(filtered.data(), output_size, element_size, output);
+    break;
+  }
+  default:
+    throw std::runtime_error("Unknown blackboard compression codec");
+  }
+}
+
+void tCompressionCodec::LZCompress(const uint8_t* input, size_t size, std::vector<uint8_t>& output)
+{
+  std::vector<uint32_t> hash_table(1 << cHASH_BITS, 0); // positions + 1 (0 means empty)
+  size_t anchor = 0;
+  size_t position = 0;
+  while (position + cMIN_MATCH <= size)
+  {
+    uint32_t& entry = hash_table[Hash(input + position)];
+    size_t candidate = entry;
+    entry = static_cast<uint32_t>(position + 1);
+    if (candidate && position - (candidate - 1) <= cMAX_OFFSET && memcmp(input + candidate - 1, input + position, cMIN_MATCH) == 0)
+    {
+      size_t match = candidate - 1;
+      size_t length = cMIN_MATCH;
+      while (position + length < size && input[match + length] == input[position + length])
+      {
+        length++;
+      }
+      WriteVarint(output, position - anchor);
+      output.insert(output.end(), input + anchor, input + position);
+      WriteVarint(output, length - cMIN_MATCH);
+      WriteVarint(output, position - match);
+      position += length;
+      anchor = position;
+    }
+    else
+    {
+      position++;
+    }
+  }
+
+  // Remaining literals (always written - also if there are none)
+  WriteVarint(output, size - anchor);
+  output.insert(output.end(), input + anchor, input + size);
+}
+
+void tCompressionCodec::LZDecompress(const uint8_t* input, size_t size, uint8_t* output, size_t output_size)
+{
+  size_t input_position = 0;
+  size_t output_position = 0;
+  while (true)
+  {
+    size_t literals = ReadVarint(input, size, input_position);
+    if (literals > size - input_position || literals > output_size - output_position)
+    {
+      throw std::runtime_error("Invalid literal count in compressed blackboard data");
+    }
+    memcpy(output + output_position, input + input_position, literals);
+    input_position += literals;
+    output_position += literals;
+    if (output_position == output_size)
+    {
+      break;
+    }
+
+    size_t length = ReadVarint(input, size, input_position) + cMIN_MATCH;
+    size_t offset = ReadVarint(input, size, input_position);
+    if (offset == 0 || offset > output_position || length > output_size - output_position)
+    {
+      throw std::runtime_error("Invalid back-reference in compressed blackboard data");
+    }
+    const uint8_t* source = output + output_position - offset;
+    for (size_t i = 0; i < length; i++) // byte-wise, since ranges may overlap
+    {
+      output[output_position + i] = source[i];
+    }
+    output_position += length;
+  }
+  if (input_position != size)
+  {
+    throw std::runtime_error("Compressed blackboard data has unexpected size");
+  }
+}
+
+void tCompressionCodec::ShuffleDelta(const uint8_t* input, size_t size, size_t element_size, uint8_t* output)
+{
+  size_t count = size / element_size;
+  for (size_t plane = 0; plane < element_size; plane++)
+  {
+    uint8_t* plane_output = output + plane * count;
+    uint8_t previous = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      uint8_t byte = input[i * element_size + plane];
+      plane_output[i] = static_cast<uint8_t>(byte - previous);
+      previous = byte;
+    }
+  }
+}
+
+void tCompressionCodec::UnshuffleDelta(const uint8_t* input, size_t size, size_t element_size, uint8_t* output)
+{
+  size_t count = size / element_size;
+  for (size_t plane = 0; plane < element_size; plane++)
+  {
+    const uint8_t* plane_input = input + plane * count;
+    uint8_t previous = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      previous = static_cast<uint8_t>(previous + plane_input[i]);
+      output[i * element_size + plane] = previous;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
@@ -0,0 +1,150 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tCompressionCodec.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tCompressionCodec
+ *
+ * \b tCompressionCodec
+ *
+ * Compresses the bytes of blackboard elements that are transferred
+ * over the network (see tCompression).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tCompressionCodec_h__
+#define __plugins__blackboard__internal__tCompressionCodec_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Compression codec for blackboard elements
+/*!
+ * Compresses the bytes of blackboard elements that are transferred over the network.
+ *
+ * The LZ codec encodes data as sequences of literal bytes - each followed by a
+ * back-reference to an earlier occurrence of the subsequent bytes (varint-encoded
+ * literal count, literals, match length and match offset).
+ * The shuffle-delta filter stores byte k of all elements in byte plane k and
+ * replaces every byte with its difference to the previous byte in the plane.
+ * For smoothly changing values (e.g. float arrays), this creates long runs of
+ * similar bytes that the LZ codec compresses well.
+ *
+ * Compressed data is not self-describing: callers store the codec and the size of the uncompressed data.
+ */
+class tCompressionCodec
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*! Data smaller than this number of bytes is not worth compressing */
+  static const size_t cMIN_INPUT_SIZE = 256;
+
+  /*!
+   * Compresses data
+   *
+   * \param input Data to compress
+   * \param size Number of bytes in input
+   * \param element_size Size of one element in bytes (size must be a multiple of it - relevant for shuffle-delta filter)
+   * \param compression Codec to use (must not be tCompression::NONE)
+   * \param output Buffer to store compressed data in (is cleared before)
+   */
+  static void Compress(const uint8_t* input, size_t size, size_t element_size, tCompression compression, std::vector<uint8_t>& output);
+
+  /*!
+   * Decompresses data
+   *
+   * \param input Compressed data
+   * \param size Number of bytes in input
+   * \param element_size Size of one element in bytes
+   * \param compression Codec that data was compressed with
+   * \param output Buffer to write uncompressed data to
+   * \param output_size Number of bytes of uncompressed data
+   * \throw Throws std::runtime_error if input is not valid compressed data
+   */
+  static void Decompress(const uint8_t* input, size_t size, size_t element_size, tCompression compression, uint8_t* output, size_t output_size);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*!
+   * Compresses data with LZ codec (appends compressed data to output)
+   */
+  static void LZCompress(const uint8_t* input, size_t size, std::vector<uint8_t>& output);
+
+  /*!
+   * Decompresses data compressed with LZCompress()
+   */
+  static void LZDecompress(const uint8_t* input, size_t size, uint8_t* output, size_t output_size);
+
+  /*!
+   * Applies shuffle-delta filter
+   */
+  static void ShuffleDelta(const uint8_t* input, size_t size, size_t element_size, uint8_t* output);
+
+  /*!
+   * Reverts shuffle-delta filter
+   */
+  static void UnshuffleDelta(const uint8_t* input, size_t size, size_t element_size, uint8_t* output);
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -0,0 +1,311 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tDeltaReplica.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tDeltaReplica
+ *
+ * \b tDeltaReplica
+ *
+ * Local copy of blackboard content that is maintained by a blackboard
+ * client from the deltas published by the blackboard server.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tDeltaReplica_h__
+#define __plugins__blackboard__internal__tDeltaReplica_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "plugins/data_ports/tInputPort.h"
+#include "plugins/data_ports/tOutputPort.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tBlackboardDelta.h"
+#include "plugins/blackboard/internal/tBufferFactory.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Blackboard content rebuilt from deltas
+/*!
+ * Local copy of blackboard content that is maintained by a blackboard
+ * client from the deltas published by the blackboard server
+ * (or from deltas polled from the blackboard server - see ApplyPolledDelta()).
+ * Received deltas are queued and applied when content is read.
+ * If deltas were missed, the replica is out of sync until the next
+ * keyframe is received.
+ *
+ * \tparam T Type of blackboard elements
+ */
+template <typename T>
+class tDeltaReplica : private rrlib::util::tNoncopyable
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef std::vector<T> tBuffer;
+  typedef data_ports::tPortDataPointer<const tBuffer> tConstBufferPointer;
+  typedef tBlackboardDelta<T> tDelta;
+
+  /*!
+   * \param parent Parent of ports to create (typically blackboard client backend)
+   * \param max_queue_length Maximum number of deltas to queue (if exceeded, replica gets out of sync)
+   */
+  tDeltaReplica(core::tFrameworkElement* parent, int max_queue_length) :
+    delta_port("read delta", parent, data_ports::tQueueSettings(false, max_queue_length)),
+    buffer_port("delta replica", parent),
+    mutex(),
+    statistics(),
+    buffer_factory(statistics),
+    current_buffer(),
+    revision(0),
+    in_sync(false),
+    keyframe_requested(false)
+  {
+    if (parent->IsReady())
+    {
+      delta_port.Init();
+      buffer_port.Init();
+    }
+  }
+
+  /*!
+   * Creates replica that is only updated with deltas polled from blackboard server (see ApplyPolledDelta())
+   *
+   * \param parent Parent of ports to create (typically blackboard client backend)
+   */
+  explicit tDeltaReplica(core::tFrameworkElement* parent) :
+    delta_port(),
+    buffer_port("polled replica", parent),
+    mutex(),
+    statistics(),
+    buffer_factory(statistics),
+    current_buffer(),
+    revision(0),
+    in_sync(false),
+    keyframe_requested(false)
+  {
+    if (parent->IsReady())
+    {
+      buffer_port.Init();
+    }
+  }
+
+  /*!
+   * Applies delta polled from blackboard server (see tBlackboardServer::ReadDelta())
+   *
+   * \param delta Delta that was created for GetKnownRevision()
+   * \return Current content of replica - or empty pointer if delta could not be applied (a keyframe needs to be polled then)
+   */
+  tConstBufferPointer ApplyPolledDelta(const tDelta& delta)
+  {
+    {
+      rrlib::thread::tLock lock(mutex);
+      if (delta.IsKeyframe() || (in_sync && delta.IsApplicableTo(revision)))
+      {
+        bool unchanged = in_sync && (!delta.IsKeyframe()) && delta.GetElementCount() == 0 &&
+                         delta.GetBufferSize() == current_buffer->GetObject().template GetData<tBuffer>().size();
+        if (unchanged)
+        {
+          revision = delta.GetRevision();
+        }
+        else
+        {
+          Apply(delta);
+        }
+      }
+      else
+      {
+        in_sync = false;
+      }
+    }
+    return Read();
+  }
+
+  /*!
+   * \return Revision of replica content to poll deltas for (std::numeric_limits<uint64_t>::max() if replica is not in sync)
+   */
+  uint64_t GetKnownRevision()
+  {
+    rrlib::thread::tLock lock(mutex);
+    return in_sync ? revision : std::numeric_limits<uint64_t>::max();
+  }
+
+  /*!
+   * \return Port that receives deltas (to be connected to blackboard server's delta port)
+   */
+  data_ports::tInputPort<tDelta> GetDeltaPort() const
+  {
+    return delta_port;
+  }
+
+  /*!
+   * \return Current content of replica - or empty pointer if replica is not in sync with blackboard server (call Update() before)
+   */
+  tConstBufferPointer Read()
+  {
+    rrlib::thread::tLock lock(mutex);
+    if (!in_sync)
+    {
+      return tConstBufferPointer();
+    }
+    current_buffer->AddLocks(1);
+    return tConstBufferPointer(data_ports::standard::tStandardPort::tLockingManagerPointer(current_buffer.get()), *buffer_port.GetWrapped());
+  }
+
+  /*!
+   * Marks replica as out of sync (e.g. because client was connected to another blackboard server)
+   * (the next call to Update() requests a keyframe)
+   */
+  void Reset()
+  {
+    rrlib::thread::tLock lock(mutex);
+    in_sync = false;
+    keyframe_requested = false;
+  }
+
+  /*!
+   * Applies all deltas received since last call
+   *
+   * \return True, if replica got out of sync and a keyframe should be requested from blackboard server
+   */
+  bool Update()
+  {
+    rrlib::thread::tLock lock(mutex);
+    bool request_keyframe = false;
+    while (true)
+    {
+      data_ports::tPortDataPointer<const tDelta> delta = delta_port.Dequeue();
+      if (!delta)
+      {
+        break;
+      }
+      if (delta->IsKeyframe() || (in_sync && delta->IsApplicableTo(revision)))
+      {
+        Apply(*delta);
+      }
+      else if (!(in_sync && delta->GetRevision() <= revision)) // deltas not newer than replica are ignored
+      {
+        in_sync = false;
+        request_keyframe |= !keyframe_requested;
+        keyframe_requested = true;
+      }
+    }
+    if ((!in_sync) && (!keyframe_requested))
+    {
+      request_keyframe = true;
+      keyframe_requested = true;
+    }
+    return request_keyframe;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Port that receives deltas */
+  data_ports::tInputPort<tDelta> delta_port;
+
+  /*! Port whose buffer pool provides buffers for replica content */
+  data_ports::tOutputPort<tBuffer> buffer_port;
+
+  /*! Mutex for replica operations */
+  rrlib::thread::tMutex mutex;
+
+  /*! Statistics on buffer reuse (required by buffer factory) */
+  tAbstractBlackboardServer::tStatistics statistics;
+
+  /*! Provides buffers for replica content */
+  tBufferFactory<T> buffer_factory;
+
+  /*! Buffer with current replica content */
+  typename data_ports::standard::tStandardPort::tLockingManagerPointer current_buffer;
+
+  /*! Revision of replica content */
+  uint64_t revision;
+
+  /*! True, if replica content equals blackboard content of 'revision' */
+  bool in_sync;
+
+  /*! True, if keyframe has been requested and not yet received */
+  bool keyframe_requested;
+
+
+  /*!
+   * Applies delta to replica content
+   * (buffer is modified in place if no one else holds a lock on it)
+   *
+   * \param delta Delta to apply
+   */
+  void Apply(const tDelta& delta)
+  {
+    if ((!current_buffer) || (!current_buffer->Unique()))
+    {
+      const tBuffer* copy_source = (current_buffer && (!delta.IsKeyframe())) ? &current_buffer->GetObject().template GetData<tBuffer>() : NULL;
+      typename tBufferFactory<T>::tBufferManagerPointer new_buffer = buffer_factory.GetBuffer(*buffer_port.GetWrapped(), copy_source);
+      buffer_factory.Recycle(std::move(current_buffer));
+      current_buffer = std::move(new_buffer);
+    }
+    delta.Apply(current_buffer->GetObject().template GetData<tBuffer>());
+    revision = delta.GetRevision();
+    in_sync = true;
+    if (delta.IsKeyframe())
+    {
+      keyframe_requested = false;
+    }
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
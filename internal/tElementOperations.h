@@ -0,0 +1,511 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tElementOperations.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tElementOperations
+ *
+ * \b tElementOperations
+ *
+ * Operations on ranges of blackboard elements.
+ * For trivially copyable element types, elements are copied with memcpy
+ * instead of being deep-copied one by one.
+ * For arithmetic element types (except of bool), elements are serialized in bulk.
+ * Arithmetic operations on single elements are available for all
+ * element types that provide the respective operators.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tElementOperations_h__
+#define __plugins__blackboard__internal__tElementOperations_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tCompressionCodec.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Whether blackboard elements of type T may be copied with memcpy
+ * (bool is excluded, as std::vector<bool> does not store its elements in an array)
+ */
+template <typename T>
+struct tIsTriviallyCopyable : std::integral_constant < bool, std::is_trivially_copyable<T>::value && !std::is_same<T, bool>::value >
+{};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Operations on ranges of blackboard elements
+/*!
+ * Operations on ranges of blackboard elements.
+ * Ranges are specified by buffer and index of first element, so that
+ * std::vector<bool> (which does not store its elements in an array) is supported, too.
+ * For trivially copyable element types, elements are copied with memcpy
+ * instead of being deep-copied one by one.
+ * For arithmetic element types (except of bool), elements are serialized in bulk
+ * (the serialized data is the same as when serializing them one by one)
+ * and may be compressed (see SerializeCompressed()).
+ *
+ * \tparam T Type of blackboard elements
+ */
+template <typename T>
+class tElementOperations
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  /*!
+   * Adds operand to element
+   *
+   * \param element Element to modify
+   * \param operand Operand
+   * \return False if element type does not support this operation
+   */
+  static bool Add(T& element, const T& operand)
+  {
+    return Add(element, operand, 0);
+  }
+
+  /*!
+   * Combines element with operand using bitwise or
+   *
+   * \param element Element to modify
+   * \param operand Operand
+   * \return False if element type does not support this operation
+   */
+  static bool BitwiseOr(T& element, const T& operand)
+  {
+    return BitwiseOr(element, operand, 0);
+  }
+
+  /*!
+   * Replaces element with operand if operand is larger
+   *
+   * \param element Element to modify
+   * \param operand Operand
+   * \return False if element type does not support this operation
+   */
+  static bool Max(T& element, const T& operand)
+  {
+    return Max(element, operand, 0);
+  }
+
+  /*!
+   * Replaces element with operand if operand is smaller
+   *
+   * \param element Element to modify
+   * \param operand Operand
+   * \return False if element type does not support this operation
+   */
+  static bool Min(T& element, const T& operand)
+  {
+    return Min(element, operand, 0);
+  }
+
+  /*!
+   * Deep-copies range of elements
+   * (storage of target elements is reused)
+   *
+   * \param source Buffer to copy elements from
+   * \param source_index Index of first element to copy
+   * \param target Buffer to copy elements to
+   * \param target_index Index of first element to copy to
+   * \param count Number of elements to copy
+   */
+  static void Copy(const std::vector<T>& source, size_t source_index, std::vector<T>& target, size_t target_index, size_t count)
+  {
+    Copy(source, source_index, target, target_index, count, tIsTriviallyCopyable<T>());
+  }
+
+  /*!
+   * Deep-copies elements from array
+   * (storage of target elements is reused)
+   *
+   * \param source First element to copy
+   * \param target Buffer to copy elements to
+   * \param target_index Index of first element to copy to
+   * \param count Number of elements to copy
+   */
+  static void Copy(const T* source, std::vector<T>& target, size_t target_index, size_t count)
+  {
+    Copy(source, target, target_index, count, tIsTriviallyCopyable<T>());
+  }
+
+  /*!
+   * Moves range of elements to other storage.
+   * Source elements are left in a valid but unspecified state
+   * (they may contain storage of former target elements for reuse).
+   *
+   * \param source Buffer to move elements from
+   * \param source_index Index of first element to move
+   * \param target Buffer to move elements to
+   * \param target_index Index of first element to move to
+   * \param count Number of elements to move
+   */
+  static void Move(std::vector<T>& source, size_t source_index, std::vector<T>& target, size_t target_index, size_t count)
+  {
+    Move(source, source_index, target, target_index, count, tIsTriviallyCopyable<T>());
+  }
+
+  /*!
+   * Deserializes range of elements (serialized with Serialize())
+   *
+   * \param stream Stream to read from
+   * \param target Buffer to deserialize elements to
+   * \param index Index of first element to deserialize
+   * \param count Number of elements
+   */
+  static void Deserialize(rrlib::serialization::tInputStream& stream, std::vector<T>& target, size_t index, size_t count)
+  {
+    Deserialize(stream, target, index, count, tSerializedInBulk());
+  }
+
+  /*!
+   * Deserializes range of elements (serialized with SerializeCompressed())
+   *
+   * \param stream Stream to read from
+   * \param target Buffer to deserialize elements to
+   * \param index Index of first element to deserialize
+   * \param count Number of elements
+   * \throw Throws std::runtime_error if stream contains invalid compressed data
+   */
+  static void DeserializeCompressed(rrlib::serialization::tInputStream& stream, std::vector<T>& target, size_t index, size_t count)
+  {
+    uint8_t compression = static_cast<uint8_t>(stream.ReadByte());
+    if (compression == static_cast<uint8_t>(tCompression::NONE))
+    {
+      Deserialize(stream, target, index, count);
+      return;
+    }
+    if (compression > static_cast<uint8_t>(tCompression::SHUFFLE_DELTA_LZ))
+    {
+      throw std::runtime_error("Unknown blackboard compression codec");
+    }
+    DeserializeCompressed(stream, target, index, count, static_cast<tCompression>(compression), tSerializedInBulk());
+  }
+
+  /*!
+   * Serializes range of elements
+   *
+   * \param stream Stream to write to
+   * \param source Buffer with elements to serialize
+   * \param index Index of first element to serialize
+   * \param count Number of elements
+   */
+  static void Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<T>& source, size_t index, size_t count)
+  {
+    Serialize(stream, source, index, count, tSerializedInBulk());
+  }
+
+  /*!
+   * Serializes range of elements - compressed, if this is possible and reduces size.
+   * The codec that was actually used is written to the stream,
+   * so receivers can deserialize data from any sender (see DeserializeCompressed()).
+   * Only arithmetic element types (except of bool) are compressed.
+   *
+   * \param stream Stream to write to
+   * \param source Buffer with elements to serialize
+   * \param index Index of first element to serialize
+   * \param count Number of elements
+   * \param compression Codec to use
+   */
+  static void SerializeCompressed(rrlib::serialization::tOutputStream& stream, const std::vector<T>& source, size_t index, size_t count, tCompression compression)
+  {
+    SerializeCompressed(stream, source, index, count, compression, tSerializedInBulk());
+  }
+
+  /*!
+   * Exchanges element in buffer with other element
+   *
+   * \param buffer Buffer that contains element
+   * \param index Index of element in buffer
+   * \param element Element to exchange buffer element with
+   */
+  static void Swap(std::vector<T>& buffer, size_t index, T& element)
+  {
+    SwapElement(buffer[index], element);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Whether elements are serialized in bulk (arithmetic types - except of bool, as std::vector<bool> does not store its elements in an array) */
+  typedef std::integral_constant < bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value > tSerializedInBulk;
+
+  template <typename U>
+  static auto Add(U& element, const U& operand, int) -> decltype(element = element + operand, true)
+  {
+    element = element + operand;
+    return true;
+  }
+
+  static bool Add(T& element, const T& operand, long)
+  {
+    return false;
+  }
+
+  template <typename U>
+  static auto BitwiseOr(U& element, const U& operand, int) -> decltype(element = element | operand, true)
+  {
+    element = element | operand;
+    return true;
+  }
+
+  static bool BitwiseOr(T& element, const T& operand, long)
+  {
+    return false;
+  }
+
+  template <typename U>
+  static auto Max(U& element, const U& operand, int) -> decltype(element < operand, true)
+  {
+    if (element < operand)
+    {
+      element = operand;
+    }
+    return true;
+  }
+
+  static bool Max(T& element, const T& operand, long)
+  {
+    return false;
+  }
+
+  template <typename U>
+  static auto Min(U& element, const U& operand, int) -> decltype(operand < element, true)
+  {
+    if (operand < element)
+    {
+      element = operand;
+    }
+    return true;
+  }
+
+  static bool Min(T& element, const T& operand, long)
+  {
+    return false;
+  }
+
+  static void Copy(const std::vector<T>& source, size_t source_index, std::vector<T>& target, size_t target_index, size_t count, std::true_type)
+  {
+    if (count)
+    {
+      std::memcpy(target.data() + target_index, source.data() + source_index, count * sizeof(T));
+    }
+  }
+
+  static void Copy(const std::vector<T>& source, size_t source_index, std::vector<T>& target, size_t target_index, size_t count, std::false_type)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      CopyElement(source[source_index + i], target[target_index + i]);
+    }
+  }
+
+  static void Copy(const T* source, std::vector<T>& target, size_t target_index, size_t count, std::true_type)
+  {
+    if (count)
+    {
+      std::memcpy(target.data() + target_index, source, count * sizeof(T));
+    }
+  }
+
+  static void Copy(const T* source, std::vector<T>& target, size_t target_index, size_t count, std::false_type)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      CopyElement(source[i], target[target_index + i]);
+    }
+  }
+
+  static void CopyElement(const T& source, T& target)
+  {
+    rrlib::rtti::GenericOperations<T>::DeepCopy(source, target);
+  }
+
+  static void CopyElement(bool source, std::vector<bool>::reference target)
+  {
+    target = source;
+  }
+
+  static void Move(std::vector<T>& source, size_t source_index, std::vector<T>& target, size_t target_index, size_t count, std::true_type)
+  {
+    Copy(source, source_index, target, target_index, count, std::true_type());
+  }
+
+  static void Move(std::vector<T>& source, size_t source_index, std::vector<T>& target, size_t target_index, size_t count, std::false_type)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      SwapElement(target[target_index + i], source[source_index + i]);
+    }
+  }
+
+  static void SwapElement(T& element1, T& element2)
+  {
+    std::swap(element1, element2);
+  }
+
+  static void SwapElement(std::vector<bool>::reference element1, std::vector<bool>::reference element2)
+  {
+    bool value = element1;
+    element1 = static_cast<bool>(element2);
+    element2 = value;
+  }
+
+  static void SwapElement(std::vector<bool>::reference element1, bool& element2)
+  {
+    bool value = element1;
+    element1 = element2;
+    element2 = value;
+  }
+
+  static void Deserialize(rrlib::serialization::tInputStream& stream, std::vector<T>& target, size_t index, size_t count, std::true_type)
+  {
+    if (count)
+    {
+      stream.ReadFully(target.data() + index, count * sizeof(T));
+    }
+  }
+
+  static void Deserialize(rrlib::serialization::tInputStream& stream, std::vector<T>& target, size_t index, size_t count, std::false_type)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      DeserializeElement(stream, target[index + i]);
+    }
+  }
+
+  static void DeserializeElement(rrlib::serialization::tInputStream& stream, T& element)
+  {
+    stream >> element;
+  }
+
+  static void DeserializeElement(rrlib::serialization::tInputStream& stream, std::vector<bool>::reference element)
+  {
+    bool value = false;
+    stream >> value;
+    element = value;
+  }
+
+  static void DeserializeCompressed(rrlib::serialization::tInputStream& stream, std::vector<T>& target, size_t index, size_t count, tCompression compression, std::true_type)
+  {
+    uint64_t compressed_size;
+    stream >> compressed_size;
+    if (compressed_size >= count * sizeof(T))
+    {
+      throw std::runtime_error("Invalid size of compressed blackboard data");
+    }
+    std::vector<uint8_t> compressed(static_cast<size_t>(compressed_size));
+    if (compressed.size())
+    {
+      stream.ReadFully(compressed.data(), compressed.size());
+    }
+    tCompressionCodec::Decompress(compressed.data(), compressed.size(), sizeof(T), compression, reinterpret_cast<uint8_t*>(target.data() + index), count * sizeof(T));
+  }
+
+  static void DeserializeCompressed(rrlib::serialization::tInputStream& stream, std::vector<T>& target, size_t index, size_t count, tCompression compression, std::false_type)
+  {
+    throw std::runtime_error("Blackboard elements of this type cannot be compressed");
+  }
+
+  static void SerializeCompressed(rrlib::serialization::tOutputStream& stream, const std::vector<T>& source, size_t index, size_t count, tCompression compression, std::true_type)
+  {
+    size_t size = count * sizeof(T);
+    if (compression != tCompression::NONE && size >= tCompressionCodec::cMIN_INPUT_SIZE)
+    {
+      std::vector<uint8_t> compressed;
+      tCompressionCodec::Compress(reinterpret_cast<const uint8_t*>(source.data() + index), size, sizeof(T), compression, compressed);
+      if (compressed.size() < size)
+      {
+        stream.WriteByte(static_cast<int8_t>(compression));
+        stream << static_cast<uint64_t>(compressed.size());
+        stream.Write(compressed.data(), compressed.size());
+        return;
+      }
+    }
+    stream.WriteByte(static_cast<int8_t>(tCompression::NONE));
+    Serialize(stream, source, index, count);
+  }
+
+  static void SerializeCompressed(rrlib::serialization::tOutputStream& stream, const std::vector<T>& source, size_t index, size_t count, tCompression compression, std::false_type)
+  {
+    stream.WriteByte(static_cast<int8_t>(tCompression::NONE));
+    Serialize(stream, source, index, count);
+  }
+
+  static void Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<T>& source, size_t index, size_t count, std::true_type)
+  {
+    if (count)
+    {
+      stream.Write(source.data() + index, count * sizeof(T));
+    }
+  }
+
+  static void Serialize(rrlib::serialization::tOutputStream& stream, const std::vector<T>& source, size_t index, size_t count, std::false_type)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      stream << source[index + i];
+    }
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
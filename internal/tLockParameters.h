@@ -40,6 +40,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <limits>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -66,6 +67,7 @@ namespace internal
 /*!
  * Parameter for blackboard write lock.
  * Main purpose of using this class is the ability to detect remote calls automatically.
+ * Optionally, a range of elements can be specified, so that only this range is locked.
  */
 class tLockParameters
 {
@@ -77,17 +79,50 @@ public:
 
   tLockParameters() :
     timeout(),
+    priority(0),
+    range_begin(0),
+    range_end(std::numeric_limits<size_t>::max()),
     remote_call(false)
   {}
 
   /*!
    * \param timeout Lock timeout in ms
+   * \param priority Priority of lock request (pending requests with higher priority are served first)
+   * \param range_begin Index of first element to lock
+   * \param range_end Index after last element to lock (std::numeric_limits<size_t>::max() locks the whole blackboard)
    */
-  tLockParameters(const rrlib::time::tDuration& timeout) :
+  tLockParameters(const rrlib::time::tDuration& timeout, int priority = 0, size_t range_begin = 0, size_t range_end = std::numeric_limits<size_t>::max()) :
     timeout(timeout),
+    priority(priority),
+    range_begin(range_begin),
+    range_end(range_end),
     remote_call(false)
   {}
 
+  /*!
+   * \return Index of first element to lock
+   */
+  size_t GetRangeBegin() const
+  {
+    return range_begin;
+  }
+
+  /*!
+   * \return Index after last element to lock
+   */
+  size_t GetRangeEnd() const
+  {
+    return range_end;
+  }
+
+  /*!
+   * \return Priority of lock request (pending requests with higher priority are served first)
+   */
+  int GetPriority() const
+  {
+    return priority;
+  }
+
   /*!
    * \return Lock timeout in ms
    */
@@ -96,6 +131,14 @@ public:
     return timeout;
   }
 
+  /*!
+   * \return True if only a range of elements is to be locked (instead of the whole blackboard)
+   */
+  bool IsRangeLock() const
+  {
+    return range_begin != 0 || range_end != std::numeric_limits<size_t>::max();
+  }
+
   /*!
    * \return Is this lock call originating from a remote runtime?
    */
@@ -114,6 +157,12 @@ private:
   /*! Lock timeout in ms */
   rrlib::time::tDuration timeout;
 
+  /*! Priority of lock request (pending requests with higher priority are served first) */
+  int priority;
+
+  /*! Range of elements to lock */
+  size_t range_begin, range_end;
+
   /*! Is this lock call originating from a remote runtime? */
   bool remote_call;
 };
@@ -121,12 +170,19 @@ private:
 inline rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tLockParameters& parameters)
 {
   stream << parameters.GetTimeout();
+  stream.WriteInt(parameters.GetPriority());
+  stream << static_cast<uint64_t>(parameters.GetRangeBegin()) << static_cast<uint64_t>(parameters.IsRangeLock() ? parameters.GetRangeEnd() : std::numeric_limits<uint64_t>::max());
   return stream;
 }
 
 inline rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tLockParameters& parameters)
 {
   stream >> parameters.timeout;
+  parameters.priority = stream.ReadInt();
+  uint64_t range_begin, range_end;
+  stream >> range_begin >> range_end;
+  parameters.range_begin = static_cast<size_t>(range_begin);
+  parameters.range_end = range_end == std::numeric_limits<uint64_t>::max() ? std::numeric_limits<size_t>::max() : static_cast<size_t>(range_end);
   parameters.remote_call = true;
   return stream;
 }
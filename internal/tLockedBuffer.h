@@ -48,6 +48,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tElementOperations.h"
 #include "plugins/blackboard/internal/tLockedBufferData.h"
 
 //----------------------------------------------------------------------
@@ -86,20 +87,28 @@ class tLockedBuffer : public rpc_ports::tPromise<tLockedBufferData<T>>
 //----------------------------------------------------------------------
 public:
 
+  typedef typename T::value_type tElement;
+
   template <typename ... TArgs>
   tLockedBuffer(TArgs && ... args) :
     data(std::forward<TArgs>(args)...),
-    buffer_source()
+    buffer_source(),
+    chunk_size(0),
+    chunk_slots()
   {
   }
 
   tLockedBuffer(tLockedBuffer && other) :
     tBase(std::forward<tBase>(other)),
     data(),
-    buffer_source()
+    buffer_source(),
+    chunk_size(0),
+    chunk_slots()
   {
     std::swap(data, other.data);
     std::swap(buffer_source, other.buffer_source);
+    std::swap(chunk_size, other.chunk_size);
+    std::swap(chunk_slots, other.chunk_slots);
   }
 
   tLockedBuffer& operator=(tLockedBuffer && other)
@@ -107,16 +116,36 @@ public:
     tBase::operator=(std::forward<tBase>(other));
     std::swap(data, other.data);
     std::swap(buffer_source, other.buffer_source);
+    std::swap(chunk_size, other.chunk_size);
+    std::swap(chunk_slots, other.chunk_slots);
     return *this;
   }
 
   /*!
    * Commits current buffer back to blackboard server
    * and releases write lock
+   *
+   * \param changed_range Range of elements that were changed (complete if unknown)
    */
-  void CommitCurrentBuffer()
+  void CommitCurrentBuffer(const tChangedRange& changed_range = tChangedRange::Complete())
   {
-    this->SetValue(tLockedBufferData<T>(std::move(data.buffer), data.lock_id));
+    if ((!data.buffer) && data.modified_chunks.size())
+    {
+      data.const_buffer.Reset(); // so that server can recycle buffer
+      tLockedBufferData<T> commit_data(std::move(data.modified_chunks), data.lock_id);
+      commit_data.changed_range = changed_range;
+      commit_data.writable_range = data.writable_range;
+      commit_data.copy_duration = data.copy_duration;
+      commit_data.compression = data.compression;
+      this->SetValue(std::move(commit_data));
+      return;
+    }
+    tLockedBufferData<T> commit_data(std::move(data.buffer), data.lock_id);
+    commit_data.changed_range = changed_range;
+    commit_data.writable_range = data.writable_range;
+    commit_data.copy_duration = data.copy_duration;
+    commit_data.compression = data.compression;
+    this->SetValue(std::move(commit_data));
   }
 
   /*!
@@ -138,21 +167,143 @@ public:
     {
       // Make copy
       assert(buffer_source.GetWrapped());
+      rrlib::time::tTimestamp copy_start = rrlib::time::Now();
       data.buffer = buffer_source.GetUnusedBuffer();
       rrlib::rtti::GenericOperations<T>::DeepCopy(*data.const_buffer, *data.buffer);
+      data.copy_duration += rrlib::time::Now() - copy_start;
       data.const_buffer.Reset(); // we do not need const_buffer anymore and it (soon) contains outdated data
+
+      // Move any modified chunks to complete copy
+      for (auto & chunk : data.modified_chunks)
+      {
+        tElementOperations<tElement>::Move(chunk.elements, 0, *data.buffer, chunk.offset, chunk.elements.size());
+      }
+      data.modified_chunks.clear();
+      chunk_slots.clear();
+      chunk_size = 0;
     }
     return data.buffer.get();
   }
 
   /*!
    * Get const version of locked buffer.
+   * (in chunked copy-on-write mode, this buffer does not contain modifications - use GetConstElement() to obtain elements)
    */
   const T* GetConst()
   {
     return data.const_buffer ? data.const_buffer.get() : data.buffer.get();
   }
 
+  /*!
+   * Get const reference to single element of locked buffer
+   * (takes modified chunks into account in chunked copy-on-write mode)
+   *
+   * \param index Element index (must be in bounds)
+   */
+  typename T::const_reference GetConstElement(size_t index)
+  {
+    if (data.buffer)
+    {
+      return (*data.buffer)[index];
+    }
+    size_t chunk_index = chunk_size ? (index / chunk_size) : 0;
+    if (chunk_index < chunk_slots.size() && chunk_slots[chunk_index])
+    {
+      const tBufferChunk<T>& chunk = data.modified_chunks[chunk_slots[chunk_index] - 1];
+      return chunk.elements[index - chunk.offset];
+    }
+    return (*data.const_buffer)[index];
+  }
+
+  /*!
+   * \return ID of lock (e.g. to renew lock lease - see tBlackboardServer::RenewLockLease())
+   */
+  uint64_t GetLockId() const
+  {
+    return data.lock_id;
+  }
+
+  /*!
+   * \return Range of elements that may be changed (complete - unless only a range of elements is locked)
+   */
+  const tChangedRange& GetWritableRange() const
+  {
+    return data.writable_range;
+  }
+
+  /*!
+   * \param index Element index
+   * \return True if element with this index may be changed
+   */
+  inline bool IsWritable(size_t index) const
+  {
+    return index >= data.writable_range.GetBegin() && index < data.writable_range.GetEnd();
+  }
+
+  /*!
+   * Get non-const reference to single element of locked buffer.
+   * In chunked copy-on-write mode, only the chunk containing the element is copied.
+   * Otherwise, this is equivalent to (*Get())[index].
+   *
+   * \param index Element index (must be in bounds)
+   */
+  typename T::reference GetElement(size_t index)
+  {
+    if (data.buffer || chunk_size == 0)
+    {
+      return (*Get())[index];
+    }
+
+    const T& source = *data.const_buffer;
+    size_t chunk_index = index / chunk_size;
+    if (chunk_slots.empty())
+    {
+      chunk_slots.resize((source.size() + chunk_size - 1) / chunk_size, 0);
+    }
+    if (!chunk_slots[chunk_index])
+    {
+      // Copy chunk
+      data.modified_chunks.emplace_back();
+      tBufferChunk<T>& chunk = data.modified_chunks.back();
+      chunk.offset = chunk_index * chunk_size;
+      size_t chunk_elements = std::min(chunk_size, source.size() - chunk.offset);
+      rrlib::rtti::ResizeVector(chunk.elements, chunk_elements);
+      tElementOperations<tElement>::Copy(source, chunk.offset, chunk.elements, 0, chunk_elements);
+      chunk_slots[chunk_index] = data.modified_chunks.size();
+    }
+    tBufferChunk<T>& chunk = data.modified_chunks[chunk_slots[chunk_index] - 1];
+    return chunk.elements[index - chunk.offset];
+  }
+
+  /*!
+   * Enables chunked copy-on-write for this locked buffer
+   * (only has an effect if only a const-buffer was provided on write lock)
+   *
+   * \param chunk_size Number of elements per chunk
+   */
+  void SetChunkedCopyOnWrite(size_t chunk_size)
+  {
+    this->chunk_size = chunk_size;
+  }
+
+  /*!
+   * \param begin Index of first element that may be changed
+   * \param end Index after last element that may be changed
+   */
+  void SetWritableRange(size_t begin, size_t end)
+  {
+    data.writable_range.Clear();
+    data.writable_range.Add(begin, end);
+  }
+
+  /*!
+   * \param compression Compression of changed elements when buffer is committed over the network
+   */
+  void SetCompression(tCompression compression)
+  {
+    data.compression = compression;
+  }
+
   /*!
    * \param buffer_source Buffer source - set if only const-buffer was provided on write lock
    */
@@ -177,6 +328,12 @@ private:
 
   /*! Buffer source - set if only const-buffer was provided on write lock */
   data_ports::tOutputPort<T> buffer_source;
+
+  /*! Number of elements per chunk in chunked copy-on-write mode (0 if disabled) */
+  size_t chunk_size;
+
+  /*! Index + 1 of copied chunk in data.modified_chunks - for every chunk of const-buffer (0 if chunk has not been copied) */
+  std::vector<size_t> chunk_slots;
 };
 
 
@@ -32,6 +32,11 @@
  * Information on locked buffer.
  * Used by tLockedBuffer class.
  *
+ * When a writer commits a buffer with a known range of changed elements
+ * over the network, only the changed elements are serialized. They are
+ * committed as a modified chunk on top of the server's current buffer.
+ * These elements are compressed with the blackboard's codec (see tCompression).
+ *
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__blackboard__internal__tLockedBufferData_h__
@@ -44,6 +49,9 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
+#include "plugins/blackboard/internal/tChangedRange.h"
+#include "plugins/blackboard/internal/tElementOperations.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -64,6 +72,23 @@ class tBlackboardServer;
 template <typename T>
 class tLockedBuffer;
 
+/*!
+ * Copied range of blackboard buffer elements.
+ * In chunked copy-on-write mode, writers copy and modify only such chunks
+ * instead of the complete buffer.
+ *
+ * \tparam T Type of locked buffer (typically tAbstractBlackboardServer<U>::tBuffer)
+ */
+template <typename T>
+struct tBufferChunk
+{
+  /*! Index of first element of chunk in blackboard buffer */
+  size_t offset;
+
+  /*! Copied (and possibly modified) elements */
+  T elements;
+};
+
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
@@ -80,42 +105,141 @@ class tLockedBufferData : public rrlib::util::tNoncopyable
 
 public:
 
+  /*! Value of buffer_size if size of blackboard buffer does not change */
+  static const size_t cUNCHANGED_BUFFER_SIZE = static_cast<size_t>(-1);
+
   tLockedBufferData() :
     const_buffer(),
     buffer(),
-    lock_id(0)
+    modified_chunks(),
+    buffer_size(cUNCHANGED_BUFFER_SIZE),
+    changed_range(tChangedRange::Complete()),
+    writable_range(tChangedRange::Complete()),
+    compression(tCompression::NONE),
+    lock_id(0),
+    copy_duration(rrlib::time::tDuration::zero())
   {}
 
   tLockedBufferData(data_ports::tPortDataPointer<const T> && const_buffer, uint64_t lock_id) :
     const_buffer(std::move(const_buffer)),
     buffer(),
-    lock_id(lock_id)
+    modified_chunks(),
+    buffer_size(cUNCHANGED_BUFFER_SIZE),
+    changed_range(tChangedRange::Complete()),
+    writable_range(tChangedRange::Complete()),
+    compression(tCompression::NONE),
+    lock_id(lock_id),
+    copy_duration(rrlib::time::tDuration::zero())
   {}
 
   tLockedBufferData(data_ports::tPortDataPointer<T> && buffer, uint64_t lock_id) :
     const_buffer(),
     buffer(std::move(buffer)),
-    lock_id(lock_id)
+    modified_chunks(),
+    buffer_size(cUNCHANGED_BUFFER_SIZE),
+    changed_range(tChangedRange::Complete()),
+    writable_range(tChangedRange::Complete()),
+    compression(tCompression::NONE),
+    lock_id(lock_id),
+    copy_duration(rrlib::time::tDuration::zero())
+  {}
+
+  tLockedBufferData(std::vector<tBufferChunk<T>> && modified_chunks, uint64_t lock_id) :
+    const_buffer(),
+    buffer(),
+    modified_chunks(std::move(modified_chunks)),
+    buffer_size(cUNCHANGED_BUFFER_SIZE),
+    changed_range(tChangedRange::Complete()),
+    writable_range(tChangedRange::Complete()),
+    compression(tCompression::NONE),
+    lock_id(lock_id),
+    copy_duration(rrlib::time::tDuration::zero())
   {}
 
   tLockedBufferData(tLockedBufferData && other) :
     const_buffer(),
     buffer(),
-    lock_id(0)
+    modified_chunks(),
+    buffer_size(cUNCHANGED_BUFFER_SIZE),
+    changed_range(tChangedRange::Complete()),
+    writable_range(tChangedRange::Complete()),
+    compression(tCompression::NONE),
+    lock_id(0),
+    copy_duration(rrlib::time::tDuration::zero())
   {
     std::swap(const_buffer, other.const_buffer);
     std::swap(buffer, other.buffer);
+    std::swap(modified_chunks, other.modified_chunks);
+    std::swap(buffer_size, other.buffer_size);
+    std::swap(changed_range, other.changed_range);
+    std::swap(writable_range, other.writable_range);
+    std::swap(compression, other.compression);
     std::swap(lock_id, other.lock_id);
+    std::swap(copy_duration, other.copy_duration);
   }
 
   tLockedBufferData& operator=(tLockedBufferData && other)
   {
     std::swap(const_buffer, other.const_buffer);
     std::swap(buffer, other.buffer);
+    std::swap(modified_chunks, other.modified_chunks);
+    std::swap(buffer_size, other.buffer_size);
+    std::swap(changed_range, other.changed_range);
+    std::swap(writable_range, other.writable_range);
+    std::swap(compression, other.compression);
     std::swap(lock_id, other.lock_id);
+    std::swap(copy_duration, other.copy_duration);
     return *this;
   }
 
+  /*!
+   * \return Size of blackboard buffer after committing modified chunks (cUNCHANGED_BUFFER_SIZE if size does not change)
+   */
+  size_t GetBufferSize() const
+  {
+    return buffer_size;
+  }
+
+  /*!
+   * \return Range of elements that were changed by writer (complete if unknown)
+   */
+  const tChangedRange& GetChangedRange() const
+  {
+    return changed_range;
+  }
+
+  /*!
+   * \return Range of elements that writer may change (complete - unless only a range of elements is locked)
+   */
+  const tChangedRange& GetWritableRange() const
+  {
+    return writable_range;
+  }
+
+  /*!
+   * \return Chunks of buffer that were copied and modified - to be committed instead of a complete buffer (see modified_chunks)
+   */
+  const std::vector<tBufferChunk<T>>& GetModifiedChunks() const
+  {
+    return modified_chunks;
+  }
+
+  /*!
+   * \param changed_range Range of elements that were changed by writer (complete if unknown)
+   */
+  void SetChangedRange(const tChangedRange& changed_range)
+  {
+    this->changed_range = changed_range;
+  }
+
+  /*!
+   * \param writable_range Range of elements that writer may change
+   */
+  void SetWritableRange(const tChangedRange& writable_range)
+  {
+    this->writable_range = writable_range;
+  }
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -138,25 +262,77 @@ private:
   /*! Locked buffer - in case blackboard's current buffer is accessed exclusively */
   data_ports::tPortDataPointer<T> buffer;
 
+  /*!
+   * Chunks of const_buffer that were copied and modified (chunked copy-on-write mode - or buffer committed over the network with known changed range)
+   * If set, only these chunks are committed back to blackboard server instead of a complete buffer.
+   */
+  std::vector<tBufferChunk<T>> modified_chunks;
+
+  /*! Size of blackboard buffer after committing modified_chunks (cUNCHANGED_BUFFER_SIZE if size does not change) */
+  size_t buffer_size;
+
+  /*! Range of elements that were changed by writer (complete if unknown) */
+  tChangedRange changed_range;
+
+  /*! Range of elements that writer may change (complete - unless only a range of elements is locked) */
+  tChangedRange writable_range;
+
+  /*! Compression of changed elements that are committed over the network (set by blackboard server) */
+  tCompression compression;
+
   /*! Lock id - to avoid obsolete unlocks - if < 0, locked_buffer is a copy */
   uint64_t lock_id;
 
+  /*! Time that local writer spent on copying buffer (not serialized - only relevant for adaptive buffer mode selection) */
+  rrlib::time::tDuration copy_duration;
+
+};
+
+/*! Content of serialized tLockedBufferData */
+enum class tLockedBufferContent : uint8_t
+{
+  NONE,    //!< No buffer
+  BUFFER,  //!< Complete buffer
+  CHANGES  //!< Buffer size and changed elements only
 };
 
 template <typename T>
 rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const tLockedBufferData<T>& buffer)
 {
   stream << buffer.lock_id;
-  bool buffer_set = buffer.const_buffer || buffer.buffer;
-  stream << buffer_set;
+  stream << buffer.changed_range;
+  stream << buffer.writable_range;
+  stream.WriteByte(static_cast<int8_t>(buffer.compression));
+
+  // Commit with known changed range? => only serialize changed elements
+  if (buffer.buffer && (!buffer.changed_range.IsComplete()))
+  {
+    const T& elements = *buffer.buffer;
+    size_t end = std::min(buffer.changed_range.GetEnd(), elements.size());
+    size_t begin = std::min(buffer.changed_range.GetBegin(), end);
+    if (end - begin < elements.size())
+    {
+      stream.WriteByte(static_cast<int8_t>(tLockedBufferContent::CHANGES));
+      stream << static_cast<uint64_t>(elements.size()) << static_cast<uint64_t>(begin) << static_cast<uint64_t>(end - begin);
+      tElementOperations<typename T::value_type>::SerializeCompressed(stream, elements, begin, end - begin, buffer.compression);
+      return stream;
+    }
+  }
+
   if (buffer.buffer)
   {
+    stream.WriteByte(static_cast<int8_t>(tLockedBufferContent::BUFFER));
     stream << buffer.buffer;
   }
   else if (buffer.const_buffer)
   {
+    stream.WriteByte(static_cast<int8_t>(tLockedBufferContent::BUFFER));
     stream << buffer.const_buffer;
   }
+  else
+  {
+    stream.WriteByte(static_cast<int8_t>(tLockedBufferContent::NONE));
+  }
   return stream;
 }
 
@@ -164,10 +340,14 @@ template <typename T>
 rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, tLockedBufferData<T>& buffer)
 {
   stream >> buffer.lock_id;
-  bool buffer_set;
-  stream >> buffer_set;
+  stream >> buffer.changed_range;
+  stream >> buffer.writable_range;
+  buffer.compression = static_cast<tCompression>(stream.ReadByte());
+  tLockedBufferContent content = static_cast<tLockedBufferContent>(stream.ReadByte());
   buffer.const_buffer.Reset();
-  if (buffer_set)
+  buffer.modified_chunks.clear();
+  buffer.buffer_size = tLockedBufferData<T>::cUNCHANGED_BUFFER_SIZE;
+  if (content == tLockedBufferContent::BUFFER)
   {
     stream >> buffer.buffer;
   }
@@ -175,6 +355,21 @@ rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStr
   {
     buffer.buffer.Reset();
   }
+  if (content == tLockedBufferContent::CHANGES)
+  {
+    uint64_t buffer_size, offset, element_count;
+    stream >> buffer_size >> offset >> element_count;
+    if (offset + element_count > buffer_size)
+    {
+      throw std::runtime_error("Invalid changed range in serialized blackboard buffer");
+    }
+    buffer.buffer_size = static_cast<size_t>(buffer_size);
+    buffer.modified_chunks.emplace_back();
+    tBufferChunk<T>& chunk = buffer.modified_chunks.back();
+    chunk.offset = static_cast<size_t>(offset);
+    rrlib::rtti::ResizeVector(chunk.elements, static_cast<size_t>(element_count));
+    tElementOperations<typename T::value_type>::DeserializeCompressed(stream, chunk.elements, 0, chunk.elements.size());
+  }
   return stream;
 }
 
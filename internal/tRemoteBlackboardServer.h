@@ -29,7 +29,9 @@
  *
  * \b tRemoteBlackboardServer
  *
- * Framework elements to represent/wrap remote blackboard servers.
+ * Local read replica of a blackboard server in another runtime environment.
+ * It is updated from the deltas published by the remote (origin) server
+ * and publishes its content via a regular read port. Writes are forwarded to the origin server.
  *
  */
 //----------------------------------------------------------------------
@@ -39,11 +41,15 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include "plugins/rpc_ports/tClientPort.h"
+#include "plugins/rpc_ports/tProxyPort.h"
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/blackboard/internal/tAbstractBlackboardServer.h"
+#include "plugins/blackboard/internal/tBlackboardServer.h"
+#include "plugins/blackboard/internal/tDeltaReplica.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -62,11 +68,32 @@ namespace internal
 //----------------------------------------------------------------------
 // Class declaration
 //----------------------------------------------------------------------
-//! Remote blackboard server proxy
+//! Local read replica of remote blackboard server
 /*!
- * Framework elements to represent/wrap remote blackboard servers.
- * TODO: Do we need this?
+ * Framework element that represents a blackboard server in another runtime environment.
+ *
+ * It maintains a local copy of the remote (origin) server's blackboard content.
+ * If the delta port (see GetDeltaPort()) is connected to the origin server's delta port
+ * (delta publishing needs to be enabled there - see tBlackboardServer::SetDeltaPublishing()),
+ * received deltas are applied by the blackboard timer thread and the replica content is published
+ * via the read port (see GetReadPort()). Missed deltas are recovered by requesting a keyframe.
+ * Synchronize() polls the elements that changed since the replica's revision instead
+ * (e.g. to obtain content before the origin server publishes any delta).
+ *
+ * Like a tBlackboardServer, the replica provides a read port and a write port.
+ * Blackboard clients connected to both ports are served locally:
+ * clients with push read port (see tBlackboardClient constructor) read the replica content
+ * (e.g. via tBlackboardReadAccess) without any network traffic.
+ * Calls on the write port (write locks, asynchronous changes etc.) are forwarded to the
+ * origin server (the write port needs to be connected to the origin server's write port).
+ * The changes become visible in the replica with the next delta.
+ *
+ * The local copy is multi-buffered: if readers still hold a lock on the current buffer,
+ * deltas are applied to a new buffer.
+ *
+ * \tparam T Type of blackboard elements
  */
+template <typename T>
 class tRemoteBlackboardServer : public tAbstractBlackboardServer
 {
 
@@ -75,13 +102,217 @@ class tRemoteBlackboardServer : public tAbstractBlackboardServer
 //----------------------------------------------------------------------
 public:
 
-  tRemoteBlackboardServer() {}
+  typedef tBlackboardServer<T> tServer;
+  typedef typename tServer::tBuffer tBuffer;
+  typedef typename tServer::tConstBufferPointer tConstBufferPointer;
+  typedef typename tServer::tDelta tDelta;
+
+  /*! Staleness of replica content compared to origin server */
+  struct tStaleness
+  {
+    /*! Number of revisions that replica content is behind origin server (std::numeric_limits<uint64_t>::max() if replica has no content yet) */
+    uint64_t revisions;
+
+    /*!
+     * Time since replica content was last known to be up to date (zero if it is up to date; tDuration::max() if replica has no content yet)
+     * (an upper bound: origin server content might have been changed later)
+     */
+    rrlib::time::tDuration age;
+  };
+
+  /*!
+   * \param name Name of replica
+   * \param parent Parent of replica
+   * \param max_queue_length Maximum number of deltas to queue between updates (if exceeded, a keyframe is requested)
+   */
+  tRemoteBlackboardServer(const std::string& name, core::tFrameworkElement* parent, int max_queue_length = 64) :
+    tAbstractBlackboardServer(parent, name, tFlags(), tBufferMode::MULTI_BUFFERED),
+    read_port("read", this),
+    write_port("write", this),
+    origin_port("origin", this, tServer::GetRPCInterfaceType()),
+    replica(this, max_queue_length),
+    published_revision(std::numeric_limits<uint64_t>::max()),
+    last_sync_time(rrlib::time::cNO_TIME)
+  {
+    this->SetBufferMode(tBufferMode::MULTI_BUFFERED, false);
+    origin_port.ConnectTo(write_port);
+    replica.GetDeltaPort().AddPortListener(*this);
+  }
+
+  /*!
+   * \return Port that receives deltas (to be connected to origin server's delta port)
+   */
+  data_ports::tInputPort<tDelta> GetDeltaPort() const
+  {
+    return replica.GetDeltaPort();
+  }
+
+  /*!
+   * \return Port that publishes replica content (to be connected to blackboard clients' read ports)
+   */
+  data_ports::tOutputPort<tBuffer> GetReadPort()
+  {
+    return read_port;
+  }
+
+  /*!
+   * Determines staleness of replica content.
+   * Queries current revision from origin server.
+   *
+   * \param timeout Timeout for call
+   * \return Staleness of replica content
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  tStaleness GetStaleness(const rrlib::time::tDuration& timeout = std::chrono::seconds(2))
+  {
+    UpdateFromDeltas();
+    uint64_t origin_revision = origin_port.CallSynchronous(timeout, &tServer::GetRevisionCounter);
+    uint64_t revision = replica.GetKnownRevision();
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    tStaleness staleness;
+    if (revision == std::numeric_limits<uint64_t>::max() || last_sync_time == rrlib::time::cNO_TIME)
+    {
+      staleness.revisions = std::numeric_limits<uint64_t>::max();
+      staleness.age = rrlib::time::tDuration::max();
+    }
+    else if (revision >= origin_revision)
+    {
+      staleness.revisions = 0;
+      staleness.age = rrlib::time::tDuration::zero();
+      last_sync_time = rrlib::time::Now();
+    }
+    else
+    {
+      staleness.revisions = origin_revision - revision;
+      staleness.age = rrlib::time::Now() - last_sync_time;
+    }
+    return staleness;
+  }
+
+  /*!
+   * \return Port that forwards calls to origin server (to be connected to origin server's write port - and to blackboard clients' write ports)
+   */
+  core::tPortWrapperBase GetWritePort()
+  {
+    return write_port;
+  }
+
+  /*!
+   * Called whenever a delta is received from origin server.
+   * Schedules update of replica content - instead of applying the delta immediately:
+   * origin server might publish deltas while holding its blackboard mutex.
+   */
+  void OnPortChange(const tDelta& delta, data_ports::tChangeContext& change_context)
+  {
+    this->ScheduleDeadline(rrlib::time::Now());
+  }
+
+  /*!
+   * Polls elements that changed since replica's revision from origin server - and publishes replica content
+   * (e.g. to obtain content before origin server publishes any delta or if delta port is not connected)
+   *
+   * \param timeout Timeout for calls
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  void Synchronize(const rrlib::time::tDuration& timeout = std::chrono::seconds(2))
+  {
+    tConstBufferPointer content = replica.ApplyPolledDelta(PollDelta(replica.GetKnownRevision(), timeout));
+    if (!content)
+    {
+      // Delta was not applicable (e.g. replica was updated by received delta in the meantime) => poll keyframe
+      replica.ApplyPolledDelta(PollDelta(std::numeric_limits<uint64_t>::max(), timeout));
+    }
+    PublishContent();
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    last_sync_time = rrlib::time::Now();
+  }
 
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  /*! Port that publishes replica content */
+  data_ports::tOutputPort<tBuffer> read_port;
+
+  /*! Port that forwards calls of connected clients to origin server */
+  rpc_ports::tProxyPort<tServer, true> write_port;
+
+  /*! Port for calls of replica to origin server (connected to write port) */
+  rpc_ports::tClientPort<tServer> origin_port;
+
+  /*! Local copy of origin server's blackboard content */
+  tDeltaReplica<T> replica;
+
+  /*! Revision of replica content that was last published via read port (std::numeric_limits<uint64_t>::max() if none was published yet) */
+  uint64_t published_revision;
+
+  /*! Time when replica content was last known to be up to date (cNO_TIME if replica has no content yet) */
+  rrlib::time::tTimestamp last_sync_time;
+
+
+  /*!
+   * Polls delta from origin server (see tBlackboardServer::ReadDelta())
+   *
+   * \param revision Revision of replica content (std::numeric_limits<uint64_t>::max() to poll keyframe)
+   * \param timeout Timeout for call
+   * \return Polled delta
+   */
+  tDelta PollDelta(uint64_t revision, const rrlib::time::tDuration& timeout)
+  {
+    return origin_port.NativeFutureCall(&tServer::ReadDelta, revision, timeout).Get(timeout);
+  }
+
+  /*!
+   * Applies deltas received from origin server (called by blackboard timer thread)
+   */
+  virtual void ProcessDeadlines() override
+  {
+    UpdateFromDeltas();
+  }
+
+  /*!
+   * Publishes replica content via read port - if it changed since last call
+   */
+  void PublishContent()
+  {
+    rrlib::thread::tLock lock(this->BlackboardMutex());
+    uint64_t revision = replica.GetKnownRevision();
+    if (revision == std::numeric_limits<uint64_t>::max() || revision == published_revision)
+    {
+      return;
+    }
+    tConstBufferPointer content = replica.Read();
+    if (content)
+    {
+      read_port.Publish(content);
+      published_revision = revision;
+      last_sync_time = rrlib::time::Now();
+    }
+  }
+
+  /*!
+   * Applies deltas received from origin server and publishes new content - and requests keyframe if deltas were missed
+   */
+  void UpdateFromDeltas()
+  {
+    bool request_keyframe = replica.Update();
+    PublishContent();
+    if (request_keyframe)
+    {
+      try
+      {
+        origin_port.Call(&tServer::RequestDeltaKeyframe);
+      }
+      catch (const rpc_ports::tRPCException& e)
+      {
+        FINROC_LOG_PRINT(WARNING, "Could not request keyframe from origin server: ", e.what());
+        replica.Reset();  // request keyframe again with next update
+      }
+    }
+  }
 };
 
 //----------------------------------------------------------------------
@@ -0,0 +1,263 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/internal/tSeqlockBuffer.h
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * \brief   Contains tSeqlockBuffer
+ *
+ * \b tSeqlockBuffer
+ *
+ * Copy of published blackboard content that is protected by a sequence lock.
+ * Readers copy content out optimistically and retry if a write occurred concurrently.
+ * They neither acquire a mutex nor lock any buffer.
+ * Only available for trivially copyable element types - for all other types,
+ * the specialization below is an empty placeholder.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __plugins__blackboard__internal__tSeqlockBuffer_h__
+#define __plugins__blackboard__internal__tSeqlockBuffer_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tChangedRange.h"
+#include "plugins/blackboard/internal/tElementOperations.h"
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace finroc
+{
+namespace blackboard
+{
+namespace internal
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+/*!
+ * Whether blackboards with element type T support seqlock reads
+ */
+template <typename T>
+struct tSupportsSeqlockReads : tIsTriviallyCopyable<T>
+{};
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Seqlock-protected copy of blackboard content
+/*!
+ * Copy of published blackboard content that is protected by a sequence lock.
+ * Readers copy content out optimistically and retry if a write occurred concurrently.
+ * They neither acquire a mutex nor lock any buffer.
+ *
+ * There is only one writer at a time (the blackboard server holding its mutex).
+ * Storage is grown geometrically. Replaced storage is kept until destruction,
+ * as readers might still be copying from it (they will retry).
+ *
+ * \tparam T Type of blackboard elements
+ */
+template <typename T, bool ENABLED = tSupportsSeqlockReads<T>::value>
+class tSeqlockBuffer
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tSeqlockBuffer() :
+    sequence(0),
+    region(NULL),
+    regions()
+  {}
+
+  /*!
+   * \return True if content has been written to this buffer (via Update())
+   */
+  bool IsEnabled() const
+  {
+    return region.load(std::memory_order_acquire) != NULL;
+  }
+
+  /*!
+   * Copies content to target buffer.
+   * Retries as long as content is written concurrently (yielding to the writer in the meantime).
+   *
+   * \param target Buffer to copy content to (resized to blackboard size)
+   * \param revision Revision of copied content (see tBlackboardServer::GetContentRevision()) is written to this variable
+   * \return False if this buffer is not enabled
+   */
+  bool Read(std::vector<T>& target, uint64_t& revision) const
+  {
+    while (true)
+    {
+      uint64_t sequence_begin = sequence.load(std::memory_order_acquire);
+      if (sequence_begin & 1)
+      {
+        std::this_thread::yield();  // write in progress
+        continue;
+      }
+      const tRegion* r = region.load(std::memory_order_acquire);
+      if (!r)
+      {
+        return false;
+      }
+      size_t size = r->size.load(std::memory_order_relaxed);
+      revision = r->revision.load(std::memory_order_relaxed);
+      target.resize(size);
+      std::memcpy(target.data(), r->data.get(), size * sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == sequence_begin)
+      {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  /*!
+   * Writes new content to this buffer
+   * (may only be called by one thread at a time - in synchronized context)
+   *
+   * \param content New content
+   * \param changed_range Range of elements that changed since last update (ignored on first update or if size changed)
+   * \param revision Revision of new content
+   */
+  void Update(const std::vector<T>& content, const tChangedRange& changed_range, uint64_t revision)
+  {
+    tRegion* r = region.load(std::memory_order_relaxed);
+    size_t begin = 0;
+    size_t end = content.size();
+    if (r && r->size.load(std::memory_order_relaxed) == content.size())
+    {
+      begin = std::min(changed_range.GetBegin(), content.size());
+      end = std::min(changed_range.GetEnd(), content.size());
+    }
+
+    uint64_t sequence_begin = sequence.load(std::memory_order_relaxed);
+    sequence.store(sequence_begin + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    if ((!r) || r->capacity < content.size())
+    {
+      regions.emplace_back(new tRegion(std::max(content.size(), r ? 2 * r->capacity : 0)));
+      r = regions.back().get();
+      begin = 0;
+      end = content.size();
+      region.store(r, std::memory_order_relaxed);
+    }
+    if (begin < end)
+    {
+      std::memcpy(r->data.get() + begin, content.data() + begin, (end - begin) * sizeof(T));
+    }
+    r->size.store(content.size(), std::memory_order_relaxed);
+    r->revision.store(revision, std::memory_order_relaxed);
+    sequence.store(sequence_begin + 2, std::memory_order_release);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  /*! Storage for content */
+  struct tRegion
+  {
+    /*! Capacity in elements */
+    const size_t capacity;
+
+    /*! Number of valid elements */
+    std::atomic<size_t> size;
+
+    /*! Revision of content */
+    std::atomic<uint64_t> revision;
+
+    /*! Elements */
+    std::unique_ptr<T[]> data;
+
+    tRegion(size_t capacity) :
+      capacity(capacity),
+      size(0),
+      revision(0),
+      data(new T[capacity > 0 ? capacity : 1])
+    {}
+  };
+
+  /*! Sequence counter (odd while a write is in progress) */
+  std::atomic<uint64_t> sequence;
+
+  /*! Current storage (NULL as long as buffer is not enabled) */
+  std::atomic<tRegion*> region;
+
+  /*! All storage regions that were allocated (replaced ones might still be accessed by readers) */
+  std::vector<std::unique_ptr<tRegion>> regions;
+};
+
+/*!
+ * Placeholder for element types that do not support seqlock reads
+ */
+template <typename T>
+class tSeqlockBuffer<T, false>
+{
+public:
+
+  bool IsEnabled() const
+  {
+    return false;
+  }
+
+  bool Read(std::vector<T>& target, uint64_t& revision) const
+  {
+    return false;
+  }
+
+  void Update(const std::vector<T>& content, const tChangedRange& changed_range, uint64_t revision)
+  {
+  }
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+}
+
+
+#endif
@@ -112,7 +112,8 @@ public:
    *
    * \param name Name of blackboard
    * \param parent Parent of blackboard
-   * \param multi_buffered Create multi-buffered blackboard?
+   * \param multi_buffered Create blackboard that is fixed to multi-buffered mode?
+   *                       (otherwise, it starts in single-buffered mode and buffer mode is selected adaptively - see tAbstractBlackboardServer::SetBufferMode())
    * \param elements Initial number of elements
    * \param create_client Create Blackboard client?
    * \param create_read_port Which read ports to create for blackboard
@@ -126,40 +127,32 @@ public:
     wrapped_client(),
     read_port()
   {
-    // Get/create Framework element to put blackboard stuff beneath
-    core::tFrameworkElement* blackboard_parent = parent->GetChild("Blackboards");
-    if (!blackboard_parent)
-    {
-      blackboard_parent = new core::tFrameworkElement(parent, "Blackboards");
-    }
-
-    // Create blackboard server
-    wrapped_server = new internal::tBlackboardServer<T>(name, blackboard_parent, multi_buffered, elements, false);
-
-    // Create blackboard client
-    if (create_client)
-    {
-      wrapped_client = tBlackboardClient<T>(*wrapped_server, blackboard_parent, "", false, create_read_port != tReadPorts::NONE);
-    }
-
-    // Possibly create read ports in module
-    if (create_read_port == tReadPorts::EXTERNAL && GetWritePortGroup(parent) != NULL)
-    {
-      typedef typename tGetReadPortType<typename std::remove_pointer<TParent>::type>::type tReadPort;
-      read_port = tReadPort(name, parent, core::tFrameworkElement::tFlag::ACCEPTS_DATA); // make this a proxy port
-      wrapped_server->GetReadPort().ConnectTo(read_port);
-    }
+    ConstructorImplementation(name, parent, multi_buffered ? tBufferMode::MULTI_BUFFERED : tBufferMode::SINGLE_BUFFERED, !multi_buffered,
+                              elements, create_client, create_read_port, create_write_port_in, create_write_port_in2);
+  }
 
-    // create write/full-access ports
-    if (create_write_port_in != NULL && GetWritePortGroup(parent) != NULL)
-    {
-      write_port1 = ReplicateWritePort(*wrapped_server->GetWritePort().GetWrapped(),
-                                       *(create_write_port_in != default_port_group ? create_write_port_in : GetWritePortGroup(parent)), name);
-    }
-    if (create_write_port_in2 != NULL && GetWritePortGroup(parent) != NULL)
-    {
-      write_port2 = ReplicateWritePort(*wrapped_server->GetWritePort().GetWrapped(), *create_write_port_in2, name);
-    }
+  /*!
+   * Constructor for use in tGroup, tModule and tSenseControlModule
+   * (same as above - but with initial buffer mode instead of multi_buffered flag:
+   *  e.g. tBufferMode::TRIPLE_BUFFERED for blackboards with a single periodic writer and many readers)
+   *
+   * \param name Name of blackboard
+   * \param parent Parent of blackboard
+   * \param buffer_mode Buffer mode (not changed adaptively - see tAbstractBlackboardServer::SetBufferMode())
+   * \param elements Initial number of elements
+   * \param create_client Create Blackboard client?
+   * \param create_read_port Which read ports to create for blackboard
+   * \param create_write_port_in If not NULL, creates write port in specified port group
+   * \param create_write_port_in2 If not NULL, creates another write port in specified port group
+   */
+  template <typename TParent>
+  tBlackboard(const std::string& name, TParent* parent, tBufferMode buffer_mode, int elements = 0, bool create_client = true,
+              tReadPorts create_read_port = tReadPorts::EXTERNAL, core::tPortGroup* create_write_port_in = default_port_group, core::tPortGroup* create_write_port_in2 = NULL) :
+    wrapped_server(NULL),
+    wrapped_client(),
+    read_port()
+  {
+    ConstructorImplementation(name, parent, buffer_mode, false, elements, create_client, create_read_port, create_write_port_in, create_write_port_in2);
   }
 
   /*!
@@ -271,6 +264,14 @@ public:
     return write_port2;
   }
 
+  /*!
+   * \return Port that publishes deltas of blackboard content (only valid if delta publishing was enabled)
+   */
+  data_ports::tOutputPort<typename tServer::tDelta> GetDeltaPort() const
+  {
+    return wrapped_server->GetDeltaPort();
+  }
+
   /*!
    * \return Port to use, when modules inside group containing blackboard want to connect to this blackboard's read port
    */
@@ -279,6 +280,30 @@ public:
     return wrapped_server->GetReadPort();
   }
 
+  /*!
+   * \return Current buffer mode of blackboard server
+   */
+  tBufferMode GetBufferMode()
+  {
+    return wrapped_server->GetBufferMode();
+  }
+
+  /*!
+   * \return Reason for current buffer mode of blackboard server
+   */
+  tBufferModeReason GetBufferModeReason()
+  {
+    return wrapped_server->GetBufferModeReason();
+  }
+
+  /*!
+   * \return Statistics on blackboard server operation
+   */
+  typename tServer::tStatistics GetStatistics()
+  {
+    return wrapped_server->GetStatistics();
+  }
+
   /*!
    * \return Revision of blackboard content (is incremented whenever blackboard content changes - signaling that a new version is available)
    */
@@ -287,6 +312,95 @@ public:
     return wrapped_server->GetRevisionCounter();
   }
 
+  /*!
+   * Enables or disables chunked copy-on-write mode
+   * (see tBlackboardServer::SetChunkedCopyOnWrite())
+   *
+   * \param chunk_size Number of elements per chunk (0 disables chunked copy-on-write mode)
+   */
+  void SetChunkedCopyOnWrite(size_t chunk_size)
+  {
+    wrapped_server->SetChunkedCopyOnWrite(chunk_size);
+  }
+
+  /*!
+   * Publishes changes that have not been published yet due to the publishing policy
+   * (see tBlackboardServer::PublishPendingChanges())
+   */
+  void PublishPendingChanges()
+  {
+    wrapped_server->PublishPendingChanges();
+  }
+
+  /*!
+   * Sets buffer mode and whether it is selected adaptively
+   * (see tAbstractBlackboardServer::SetBufferMode())
+   *
+   * \param mode Buffer mode
+   * \param adaptive Select buffer mode adaptively from now on? (otherwise, the specified mode is kept)
+   */
+  void SetBufferMode(tBufferMode mode, bool adaptive = false)
+  {
+    wrapped_server->SetBufferMode(mode, adaptive);
+  }
+
+  /*!
+   * Enables or disables publishing of deltas
+   * (see tBlackboardServer::SetDeltaPublishing())
+   *
+   * \param keyframe_interval Interval of keyframes (0 disables delta publishing)
+   */
+  void SetDeltaPublishing(size_t keyframe_interval)
+  {
+    wrapped_server->SetDeltaPublishing(keyframe_interval);
+  }
+
+  /*!
+   * Sets duration of leases for write locks that are held by remote clients
+   * (see tBlackboardServer::SetLockLeaseDuration())
+   *
+   * \param duration Lease duration (zero disables leases; default)
+   */
+  void SetLockLeaseDuration(const rrlib::time::tDuration& duration)
+  {
+    wrapped_server->SetLockLeaseDuration(duration);
+  }
+
+  /*!
+   * Partitions index space of blackboard into shards that can be write-locked independently
+   * (see tBlackboardServer::SetShardCount())
+   *
+   * \param shard_count Number of shards (1 by default)
+   */
+  void SetShardCount(size_t shard_count)
+  {
+    wrapped_server->SetShardCount(shard_count);
+  }
+
+  /*!
+   * Sets policy that determines when changed blackboard content is published
+   * (see tBlackboardServer::SetPublishingPolicy())
+   *
+   * \param policy Publishing policy (IMMEDIATE by default)
+   * \param min_interval Minimum interval between two publishes (MAX_RATE) or period (PERIODIC)
+   */
+  void SetPublishingPolicy(tPublishingPolicy policy, const rrlib::time::tDuration& min_interval = rrlib::time::tDuration::zero())
+  {
+    wrapped_server->SetPublishingPolicy(policy, min_interval);
+  }
+
+  /*!
+   * Configures retention of published revisions
+   * (see tBlackboardServer::SetRevisionRetention() - disables recycling of buffers in chunked copy-on-write mode)
+   *
+   * \param max_revisions Maximum number of revisions to retain (0 disables retention)
+   * \param max_age Revisions that have been replaced longer ago are discarded (zero for no time limit)
+   */
+  void SetRevisionRetention(size_t max_revisions, const rrlib::time::tDuration& max_age = rrlib::time::tDuration::zero())
+  {
+    wrapped_server->SetRevisionRetention(max_revisions, max_age);
+  }
+
   /*!
    * \return Port to use, when modules inside group containing blackboard want to connect to this blackboard's primary write port
    */
@@ -310,6 +424,52 @@ private:
   data_ports::tPort<std::vector<T>> read_port;
 
 
+  /*!
+   * Code that would be identical in all constructors for use in tGroup, tModule and tSenseControlModule
+   * (parameters are described there)
+   *
+   * \param adaptive_buffer_mode Select buffer mode adaptively - starting with buffer_mode?
+   */
+  template <typename TParent>
+  void ConstructorImplementation(const std::string& name, TParent* parent, tBufferMode buffer_mode, bool adaptive_buffer_mode, int elements, bool create_client,
+                                 tReadPorts create_read_port, core::tPortGroup* create_write_port_in, core::tPortGroup* create_write_port_in2)
+  {
+    // Get/create Framework element to put blackboard stuff beneath
+    core::tFrameworkElement* blackboard_parent = parent->GetChild("Blackboards");
+    if (!blackboard_parent)
+    {
+      blackboard_parent = new core::tFrameworkElement(parent, "Blackboards");
+    }
+
+    // Create blackboard server
+    wrapped_server = new internal::tBlackboardServer<T>(name, blackboard_parent, buffer_mode, elements, false, adaptive_buffer_mode);
+
+    // Create blackboard client
+    if (create_client)
+    {
+      wrapped_client = tBlackboardClient<T>(*wrapped_server, blackboard_parent, "", false, create_read_port != tReadPorts::NONE);
+    }
+
+    // Possibly create read ports in module
+    if (create_read_port == tReadPorts::EXTERNAL && GetWritePortGroup(parent) != NULL)
+    {
+      typedef typename tGetReadPortType<typename std::remove_pointer<TParent>::type>::type tReadPort;
+      read_port = tReadPort(name, parent, core::tFrameworkElement::tFlag::ACCEPTS_DATA); // make this a proxy port
+      wrapped_server->GetReadPort().ConnectTo(read_port);
+    }
+
+    // create write/full-access ports
+    if (create_write_port_in != NULL && GetWritePortGroup(parent) != NULL)
+    {
+      write_port1 = ReplicateWritePort(*wrapped_server->GetWritePort().GetWrapped(),
+                                       *(create_write_port_in != default_port_group ? create_write_port_in : GetWritePortGroup(parent)), name);
+    }
+    if (create_write_port_in2 != NULL && GetWritePortGroup(parent) != NULL)
+    {
+      write_port2 = ReplicateWritePort(*wrapped_server->GetWritePort().GetWrapped(), *create_write_port_in2, name);
+    }
+  }
+
   template <typename TParent>
   struct tGetReadPortType
   {
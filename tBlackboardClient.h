@@ -43,6 +43,7 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include "core/tRuntimeEnvironment.h"
 #include "plugins/rpc_ports/tProxyPort.h"
 #include "plugins/structure/tSenseControlGroup.h"
 #include "plugins/structure/tModule.h"
@@ -53,6 +54,7 @@
 #include "plugins/blackboard/tChange.h"
 #include "plugins/blackboard/internal/tBlackboardClientBackend.h"
 #include "plugins/blackboard/internal/tBlackboardServer.h"
+#include "plugins/blackboard/internal/tDeltaReplica.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -114,7 +116,10 @@ public:
     backend(NULL),
     outside_write_port1(),
     outside_write_port2(),
-    outside_read_port()
+    outside_read_port(),
+    delta_replica(),
+    local_server_handle(0),
+    local_server(NULL)
   {
   }
 
@@ -191,6 +196,36 @@ public:
     write_port.Call(&tServer::AsynchronousChange, std::move(change_set));
   }
 
+  /*!
+   * Apply change transaction to blackboard asynchronously - and obtain results of atomic operations
+   * (see tChange::Add(), tChange::CompareAndSwap() etc.).
+   * Atomic operations are evaluated on the server - so concurrent changes by other clients are not lost.
+   *
+   * \param change_set Change set to apply
+   * \return Future with previous values of elements changed by atomic operations (in order of atomic operations in change set)
+   */
+  rpc_ports::tFuture<tBuffer> AsynchronousChangeWithResults(tChangeSetPointer& change_set)
+  {
+    return write_port.NativeFutureCall(&tServer::AsynchronousChangeWithResults, std::move(change_set));
+  }
+
+  /*!
+   * Optimistic commit: Applies change transaction to blackboard - but only if blackboard content
+   * has not changed since the specified revision (see ReadSnapshot()).
+   * For writers that rarely conflict, this avoids lock and unlock calls (and waiting for locks).
+   * On conflict, a new snapshot should be read and the change set recomputed.
+   *
+   * \param revision Revision of snapshot that change set was computed from
+   * \param change_set Change set to apply
+   * \param timeout Timeout for call
+   * \return True if change set was applied - false on conflict
+   * \throws Throws an tRPCException if blackboard is not connected or timeout expired
+   */
+  bool CommitIfRevision(uint64_t revision, tChangeSetPointer& change_set, const rrlib::time::tDuration& timeout = std::chrono::seconds(2))
+  {
+    return write_port.CallSynchronous(timeout, &tServer::CommitIfRevision, revision, std::move(change_set));
+  }
+
   /*!
    * Connect to outside ports of specified blackboard
    *
@@ -205,6 +240,24 @@ public:
    */
   void ConnectTo(const tBlackboardClient<T>& client);
 
+  /*!
+   * Enables maintaining a local copy of blackboard content from deltas published by blackboard server.
+   * Read() and ReadLock() then return this local copy (as long as it is in sync with the server).
+   * This requires the delta port (see GetDeltaPort()) to be connected to the server's delta port
+   * and delta publishing to be enabled on the server (see tBlackboardServer::SetDeltaPublishing()).
+   * Compared to push updates of the complete blackboard, this greatly reduces network bandwidth
+   * for large blackboards that are changed partially.
+   *
+   * \param max_queue_length Maximum number of deltas to queue between reads (if exceeded, a keyframe is requested)
+   */
+  void EnableDeltaUpdates(int max_queue_length = 64)
+  {
+    if (!delta_replica)
+    {
+      delta_replica.reset(new internal::tDeltaReplica<T>(backend, max_queue_length));
+    }
+  }
+
   /*!
    * \return Blackboard name
    */
@@ -213,6 +266,14 @@ public:
     return backend->GetName();
   }
 
+  /*!
+   * \return Port that receives deltas from blackboard server (only exists if EnableDeltaUpdates() was called)
+   */
+  data_ports::tInputPort<typename tServer::tDelta> GetDeltaPort() const
+  {
+    return delta_replica ? delta_replica->GetDeltaPort() : data_ports::tInputPort<typename tServer::tDelta>();
+  }
+
   /*!
    * \return Port to use, when modules outside of group/module containing blackboard want to connect to this blackboard's read port. May not exist.
    */
@@ -336,6 +397,10 @@ public:
    * (only exception: this is the first read lock performed on a
    * single-buffered blackboard that currently has a write lock)
    *
+   * If the blackboard server is in another runtime environment, the client keeps a local copy
+   * of the content read most recently - and only elements that changed since then are
+   * transferred (see ReadDelta()).
+   *
    * \param timeout Timeout for call
    * \return Current Blackboard Contents
    *
@@ -343,6 +408,14 @@ public:
    */
   inline tConstBufferPointer Read(const rrlib::time::tDuration& timeout = std::chrono::seconds(2))
   {
+    if (delta_replica)
+    {
+      tConstBufferPointer replica_content = ReadDeltaReplica();
+      if (replica_content)
+      {
+        return replica_content;
+      }
+    }
     if (read_port && read_port.GetFlag(core::tFrameworkElement::tFlag::PUSH_STRATEGY))
     {
       return read_port.GetPointer();
@@ -351,6 +424,31 @@ public:
     return future.Get(timeout);
   }
 
+  /*!
+   * Copies current blackboard content to provided buffer.
+   *
+   * If the blackboard server is in the same runtime environment and blackboard elements are trivially copyable,
+   * content is copied from the server's seqlock-protected copy - without acquiring any mutex, locking any buffer
+   * or performing an RPC call (see tBlackboardServer::ReadCopy()).
+   * Otherwise, the result of Read() is copied.
+   *
+   * \param target Buffer to copy content to
+   * \param timeout Timeout for call (only relevant if content cannot be copied directly)
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  void ReadCopy(tBuffer& target, const rrlib::time::tDuration& timeout = std::chrono::seconds(2))
+  {
+    uint64_t revision = 0;
+    tServer* server = internal::tSupportsSeqlockReads<T>::value ? GetLocalServer() : NULL;
+    if (server && server->ReadCopy(target, revision))
+    {
+      return;
+    }
+    tConstBufferPointer buffer = Read(timeout);
+    rrlib::rtti::GenericOperations<tBuffer>::DeepCopy(*buffer, target);
+  }
+
   /*!
    * Acquire read "lock" on blackboard.
    *
@@ -360,6 +458,9 @@ public:
    * (only exception: this is the first read lock performed on a
    * single-buffered blackboard that currently has a write lock)
    *
+   * As with Read(), only elements that changed since the last call are transferred
+   * if the blackboard server is in another runtime environment.
+   *
    * \param timeout Timeout for call
    * \return Future on locked buffer
    *
@@ -367,6 +468,88 @@ public:
    */
   rpc_ports::tFuture<tConstBufferPointer> ReadLock(const rrlib::time::tDuration& timeout = std::chrono::seconds(10));
 
+  /*!
+   * Reads blackboard content relative to content that caller already has
+   * (see tBlackboardServer::ReadDelta()).
+   * Read() and ReadLock() use this internally when blackboard server is in another runtime environment.
+   *
+   * \param known_revision Revision of blackboard content that caller has (std::numeric_limits<uint64_t>::max() if none)
+   * \param timeout Timeout for call
+   * \return Future on delta that transforms known revision into current content
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  rpc_ports::tFuture<typename tServer::tDelta> ReadDelta(uint64_t known_revision, const rrlib::time::tDuration& timeout = std::chrono::seconds(10))
+  {
+    return write_port.NativeFutureCall(&tServer::ReadDelta, known_revision, timeout);
+  }
+
+  /*!
+   * Acquire read "lock" on retained revision of blackboard content
+   * (server must retain revisions - see tBlackboardServer::SetRevisionRetention())
+   *
+   * \param revision Revision to lock (see GetRevision())
+   * \return Future on locked buffer (contains empty pointer if revision is not retained)
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  rpc_ports::tFuture<tConstBufferPointer> ReadLockAtRevision(uint64_t revision)
+  {
+    return write_port.NativeFutureCall(&tServer::ReadLockAtRevision, revision);
+  }
+
+  /*!
+   * Acquire read "lock" on blackboard content that was current at specified point in time
+   * (server must retain revisions - see tBlackboardServer::SetRevisionRetention())
+   *
+   * \param timestamp Point in time (e.g. timestamp of sensor data that blackboard content should match)
+   * \return Future on locked buffer (contains empty pointer if no revision from this time is retained)
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  rpc_ports::tFuture<tConstBufferPointer> ReadLockAtTime(const rrlib::time::tTimestamp& timestamp)
+  {
+    return write_port.NativeFutureCall(&tServer::ReadLockAtTime, timestamp);
+  }
+
+  /*!
+   * Reads snapshot of blackboard content for an optimistic transaction (see CommitIfRevision()).
+   * The snapshot is obtained from the server (not from push read port or delta replica), so that
+   * its content is at least as recent as the returned revision.
+   *
+   * \param revision Content revision to pass to CommitIfRevision() is stored here (see tBlackboardServer::GetContentRevision())
+   * \param timeout Timeout for calls
+   * \return Locked buffer with snapshot
+   * \throws Throws an tRPCException if blackboard is not connected or timeout expired
+   */
+  tConstBufferPointer ReadSnapshot(uint64_t& revision, const rrlib::time::tDuration& timeout = std::chrono::seconds(2))
+  {
+    revision = write_port.CallSynchronous(timeout, &tServer::GetContentRevision);
+    rpc_ports::tFuture<tConstBufferPointer> future = write_port.NativeFutureCall(&tServer::ReadLock, timeout);
+    return future.Get(timeout);
+  }
+
+  /*!
+   * Requests blackboard server to publish a keyframe on its delta port
+   * (e.g. because deltas were missed - see tBlackboardServer::RequestDeltaKeyframe())
+   */
+  void RequestDeltaKeyframe()
+  {
+    write_port.Call(&tServer::RequestDeltaKeyframe);
+  }
+
+  /*!
+   * Renews lease of remote write lock (see tBlackboardServer::SetLockLeaseDuration()).
+   * Writers that hold a remote write lock longer than the server's lease duration need to call this regularly
+   * (tBlackboardWriteAccess::KeepAlive() is more convenient).
+   *
+   * \param lock_id ID of lock (see tLockedBuffer::GetLockId())
+   */
+  void RenewLockLease(uint64_t lock_id)
+  {
+    write_port.Call(&tServer::RenewLockLease, lock_id);
+  }
+
   /*!
    * (only works properly if pushUpdates in constructor was set to true)
    *
@@ -380,19 +563,61 @@ public:
     }
   }
 
+  /*!
+   * Acquire write lock on range of shards of blackboard (see tBlackboardServer::ShardWriteLock()).
+   *
+   * This will block if another client has a write lock on any of these shards - or on the whole blackboard.
+   *
+   * \param first_shard Index of first shard to lock
+   * \param shard_count Number of shards to lock
+   * \param timeout Timeout for call
+   * \param priority Priority of lock request
+   * \return Future on locked buffer
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  rpc_ports::tFuture<internal::tLockedBuffer<tBuffer>> ShardWriteLock(size_t first_shard, size_t shard_count, const rrlib::time::tDuration& timeout = std::chrono::seconds(10), int priority = 0)
+  {
+    return write_port.NativeFutureCall(&tServer::ShardWriteLock, internal::tLockParameters(timeout, priority), static_cast<uint32_t>(first_shard), static_cast<uint32_t>(shard_count));
+  }
+
   /*!
    * Acquire write lock on blackboard.
    *
    * This will block if another client has a write lock on this blackboard.
+   * Pending lock requests are served in order of priority - and earliest deadline (timeout) first among equal priorities.
+   *
+   * If the blackboard server is in another runtime environment, the locked buffer contains the complete
+   * blackboard content (transferred when the lock is granted). On commit, only the range from the first
+   * to the last changed element is transferred back - if the changed range is known (see tBlackboardWriteAccess).
    *
    * \param timeout Timeout for call
+   * \param priority Priority of lock request
    * \return Future on locked buffer
    *
    * \exception rpc_ports::tRPCException is thrown if call fails
    */
-  rpc_ports::tFuture<internal::tLockedBuffer<tBuffer>> WriteLock(const rrlib::time::tDuration& timeout = std::chrono::seconds(10))
+  rpc_ports::tFuture<internal::tLockedBuffer<tBuffer>> WriteLock(const rrlib::time::tDuration& timeout = std::chrono::seconds(10), int priority = 0)
   {
-    return write_port.NativeFutureCall(&tServer::WriteLock, internal::tLockParameters(timeout));
+    return write_port.NativeFutureCall(&tServer::WriteLock, internal::tLockParameters(timeout, priority));
+  }
+
+  /*!
+   * Acquire write lock on range of elements in blackboard.
+   *
+   * This will block if another client has a write lock on any of these elements - or on the whole blackboard.
+   * Changes to elements outside of this range are discarded on commit.
+   *
+   * \param range Range of elements to lock
+   * \param timeout Timeout for call
+   * \param priority Priority of lock request
+   * \return Future on locked buffer
+   *
+   * \exception rpc_ports::tRPCException is thrown if call fails
+   */
+  rpc_ports::tFuture<internal::tLockedBuffer<tBuffer>> WriteLock(const tElementRange& range, const rrlib::time::tDuration& timeout = std::chrono::seconds(10), int priority = 0)
+  {
+    return write_port.NativeFutureCall(&tServer::WriteLock, internal::tLockParameters(timeout, priority, range.begin, range.end));
   }
 
 
@@ -421,6 +646,21 @@ private:
   /*! Replicated read port in group's/module's tPortGroups */
   data_ports::tPort<tBuffer> outside_read_port;
 
+  /*! Local copy of blackboard content maintained from deltas (only exists if EnableDeltaUpdates() was called) */
+  std::unique_ptr<internal::tDeltaReplica<T>> delta_replica;
+
+  /*! Local copy of blackboard content maintained from deltas polled by Read()/ReadLock() (only exists if server is in another runtime environment) */
+  std::unique_ptr<internal::tDeltaReplica<T>> polled_replica;
+
+  /*! Handle of server port that local_server was determined for */
+  typename core::tFrameworkElement::tHandle local_server_handle;
+
+  /*! Blackboard server that client is connected to - if it is in the same runtime environment (NULL otherwise) */
+  tServer* local_server;
+
+  /*! Mutex for local_server, local_server_handle and creation of polled_replica (Read() may be called from multiple threads) */
+  rrlib::thread::tMutex local_server_mutex;
+
 
   /*!
    * Check whether these ports can be connected - if yes, do so
@@ -434,6 +674,26 @@ private:
    */
   void CheckClientConnect(core::tPortWrapperBase p1, core::tPortWrapperBase p2);
 
+  /*!
+   * \return Blackboard server that client is connected to - if it is in the same runtime environment (NULL otherwise)
+   */
+  tServer* GetLocalServer()
+  {
+    rrlib::thread::tLock lock(local_server_mutex);
+    typename core::tFrameworkElement::tHandle server_handle = write_port.GetServerHandle();
+    if (server_handle != local_server_handle)
+    {
+      core::tFrameworkElement* server_port = server_handle ? core::tRuntimeEnvironment::GetInstance().GetElement(server_handle) : NULL;
+      local_server = server_port ? dynamic_cast<tServer*>(server_port->GetParent()) : NULL;
+      local_server_handle = server_handle;
+      if (polled_replica)
+      {
+        polled_replica->Reset();
+      }
+    }
+    return local_server;
+  }
+
   /*!
    * \return Log description
    */
@@ -442,6 +702,46 @@ private:
     return *backend;
   }
 
+  /*!
+   * Applies received deltas to local copy of blackboard content - and requests keyframe if deltas were missed
+   *
+   * \return Local copy of blackboard content (empty pointer if it is not in sync with server)
+   */
+  tConstBufferPointer ReadDeltaReplica()
+  {
+    if (delta_replica->Update())
+    {
+      write_port.Call(&tServer::RequestDeltaKeyframe);
+    }
+    return delta_replica->Read();
+  }
+
+  /*!
+   * Updates local copy of blackboard content with delta polled from blackboard server
+   *
+   * \param timeout Timeout for calls
+   * \return Local copy of blackboard content
+   */
+  tConstBufferPointer ReadPolledReplica(const rrlib::time::tDuration& timeout)
+  {
+    internal::tDeltaReplica<T>* replica = NULL;
+    {
+      rrlib::thread::tLock lock(local_server_mutex);
+      if (!polled_replica)
+      {
+        polled_replica.reset(new internal::tDeltaReplica<T>(backend));
+      }
+      replica = polled_replica.get();  // replica is only deleted with client; its operations are synchronized internally
+    }
+    tConstBufferPointer content = replica->ApplyPolledDelta(ReadDelta(replica->GetKnownRevision(), timeout).Get(timeout));
+    if (!content)
+    {
+      // Delta was not applicable (e.g. replica was updated by concurrent call in the meantime) => poll keyframe
+      content = replica->ApplyPolledDelta(ReadDelta(std::numeric_limits<uint64_t>::max(), timeout).Get(timeout));
+    }
+    return content;
+  }
+
   /*!
    * (Helper to make constructors shorter)
    * Creates read port
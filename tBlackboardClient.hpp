@@ -71,7 +71,11 @@ tBlackboardClient<T>::tBlackboardClient(const std::string& name, core::tFramewor
   backend(new internal::tBlackboardClientBackend(name, parent, write_port, read_port)),
   outside_write_port1(),
   outside_write_port2(),
-  outside_read_port()
+  outside_read_port(),
+  delta_replica(),
+  polled_replica(),
+  local_server_handle(0),
+  local_server(NULL)
 {
   //backend->SetAutoConnectMode(auto_connect_mode);
 }
@@ -83,7 +87,11 @@ tBlackboardClient<T>::tBlackboardClient(internal::tBlackboardServer<T>& server,
   backend(new internal::tBlackboardClientBackend(non_default_name.length() > 0 ? non_default_name : (server.GetName() + " Client"), parent, write_port, read_port)),
   outside_write_port1(),
   outside_write_port2(),
-  outside_read_port()
+  outside_read_port(),
+  delta_replica(),
+  polled_replica(),
+  local_server_handle(0),
+  local_server(NULL)
 {
   if (create_read_port)
   {
@@ -99,7 +107,11 @@ tBlackboardClient<T>::tBlackboardClient(const std::string& name, structure::tMod
   backend(new internal::tBlackboardClientBackend(name, parent->GetChild("Blackboards") ? parent->GetChild("Blackboards") : new core::tFrameworkElement(parent, "Blackboards"), write_port, read_port)),
   outside_write_port1(),
   outside_write_port2(),
-  outside_read_port()
+  outside_read_port(),
+  delta_replica(),
+  polled_replica(),
+  local_server_handle(0),
+  local_server(NULL)
 {
   structure::tModule* module = dynamic_cast<structure::tModule*>(parent);
   structure::tSenseControlModule* sense_control_module = dynamic_cast<structure::tSenseControlModule*>(parent);
@@ -135,7 +147,11 @@ tBlackboardClient<T>::tBlackboardClient(const tBlackboardClient& replicated_bb,
   backend(NULL),
   outside_write_port1(),
   outside_write_port2(),
-  outside_read_port()
+  outside_read_port(),
+  delta_replica(),
+  polled_replica(),
+  local_server_handle(0),
+  local_server(NULL)
 {
   // forward read port
   if (replicated_bb.GetOutsideReadPort().GetWrapped())
@@ -218,7 +234,11 @@ tBlackboardClient<T>::tBlackboardClient(tBlackboardClient && o) :
   backend(NULL),
   outside_write_port1(),
   outside_write_port2(),
-  outside_read_port()
+  outside_read_port(),
+  delta_replica(),
+  polled_replica(),
+  local_server_handle(0),
+  local_server(NULL)
 {
   std::swap(read_port, o.read_port);
   std::swap(write_port, o.write_port);
@@ -226,6 +246,10 @@ tBlackboardClient<T>::tBlackboardClient(tBlackboardClient && o) :
   std::swap(outside_write_port1, o.outside_write_port1);
   std::swap(outside_write_port2, o.outside_write_port2);
   std::swap(outside_read_port, o.outside_read_port);
+  std::swap(delta_replica, o.delta_replica);
+  std::swap(polled_replica, o.polled_replica);
+  std::swap(local_server_handle, o.local_server_handle);
+  std::swap(local_server, o.local_server);
 }
 
 template<typename T>
@@ -237,6 +261,10 @@ tBlackboardClient<T>& tBlackboardClient<T>::operator=(tBlackboardClient && o)
   std::swap(outside_write_port1, o.outside_write_port1);
   std::swap(outside_write_port2, o.outside_write_port2);
   std::swap(outside_read_port, o.outside_read_port);
+  std::swap(delta_replica, o.delta_replica);
+  std::swap(polled_replica, o.polled_replica);
+  std::swap(local_server_handle, o.local_server_handle);
+  std::swap(local_server, o.local_server);
   return *this;
 }
 
@@ -323,6 +351,18 @@ bool tBlackboardClient<T>::HasChanged() const
 template<typename T>
 rpc_ports::tFuture<typename tBlackboardClient<T>::tConstBufferPointer> tBlackboardClient<T>::ReadLock(const rrlib::time::tDuration& timeout)
 {
+  // Possibly obtain value from local copy maintained from deltas
+  if (delta_replica)
+  {
+    tConstBufferPointer replica_content = ReadDeltaReplica();
+    if (replica_content)
+    {
+      rpc_ports::tPromise<tConstBufferPointer> promise;
+      promise.SetValue(std::move(replica_content));
+      return promise.GetFuture();
+    }
+  }
+
   // Possibly obtain value from read_port
   if (read_port.GetWrapped() && read_port.GetFlag(core::tFrameworkElement::tFlag::PUSH_STRATEGY))
   {
@@ -331,6 +371,21 @@ rpc_ports::tFuture<typename tBlackboardClient<T>::tConstBufferPointer> tBlackboa
     return promise.GetFuture();
   }
 
+  // Server in another runtime environment: only transfer elements that changed since last call
+  if (write_port.GetServerHandle() && (!GetLocalServer()))
+  {
+    rpc_ports::tPromise<tConstBufferPointer> promise;
+    try
+    {
+      promise.SetValue(ReadPolledReplica(timeout));
+    }
+    catch (const rpc_ports::tRPCException& e)
+    {
+      promise.SetException(e.GetType());
+    }
+    return promise.GetFuture();
+  }
+
   return write_port.NativeFutureCall(&tServer::ReadLock, timeout);
 }
 
@@ -88,6 +88,7 @@ public:
     locked_buffer_future(),
     locked_buffer(),
     locked_buffer_raw(NULL),
+    write_locked_buffer(NULL),
     timeout(timeout)
   {
     ConstructorImplementation(deferred_lock_check);
@@ -104,6 +105,7 @@ public:
     locked_buffer_future(),
     locked_buffer(),
     locked_buffer_raw(NULL),
+    write_locked_buffer(NULL),
     timeout(timeout)
   {
     ConstructorImplementation(deferred_lock_check);
@@ -117,7 +119,7 @@ public:
     }
   }
 
-  inline const T& operator[](size_t index)
+  inline typename std::vector<T>::const_reference operator[](size_t index)
   {
     return Get(index);
   }
@@ -128,14 +130,14 @@ public:
    *
    * \exception tLockException is thrown if lock fails (can only occur if locking was deferred in constructor)
    */
-  inline const T& Get(size_t index)
+  inline typename std::vector<T>::const_reference Get(size_t index)
   {
     CheckLock();
     if (index >= locked_buffer_raw->size())
     {
       throw std::runtime_error("Blackboard read access out of bounds");
     }
-    return (*locked_buffer_raw)[index];
+    return write_locked_buffer ? write_locked_buffer->GetConstElement(index) : (*locked_buffer_raw)[index];
   }
 
   /*!
@@ -172,6 +174,9 @@ private:
   /*! Buffer from locked blackboard - as raw pointer (so that it can set from subclass also) */
   const tBuffer* locked_buffer_raw;
 
+  /*! Locked buffer of tBlackboardWriteAccess - if this is one (may contain modified elements not in locked_buffer_raw) */
+  internal::tLockedBuffer<tBuffer>* write_locked_buffer;
+
   /*! Timeout for buffer lock - stored for deferred locks */
   rrlib::time::tDuration timeout;
 
@@ -181,7 +186,8 @@ private:
     blackboard(blackboard),
     locked_buffer_future(),
     locked_buffer(),
-    locked_buffer_raw(NULL)
+    locked_buffer_raw(NULL),
+    write_locked_buffer(NULL)
   {
   }
 
@@ -35,6 +35,14 @@
  * This class is derived from tBlackboardReadAccess so that it can also
  * be used in places where only read access is required.
  *
+ * Write access may be restricted to a range of elements (or shards) of the blackboard.
+ * Write accesses to disjoint ranges can be held concurrently.
+ *
+ * If the blackboard server is in another runtime environment, granting write access
+ * transfers the complete blackboard content. Only the commit is reduced to changed elements:
+ * the range from the first to the last element changed (including unchanged elements between
+ * scattered changes) is transferred back.
+ *
  */
 //----------------------------------------------------------------------
 #ifndef __plugins__blackboard__tBlackboardWriteAccess_h__
@@ -71,6 +79,14 @@ namespace blackboard
  *
  * This class is derived from tBlackboardReadAccess so that it can also
  * be used in places where only read access is required.
+ *
+ * Write access may be restricted to a range of elements (or shards) of the blackboard.
+ * Write accesses to disjoint ranges can be held concurrently.
+ *
+ * If the blackboard server is in another runtime environment, granting write access
+ * transfers the complete blackboard content. Only the commit is reduced to changed elements:
+ * the range from the first to the last element changed (including unchanged elements between
+ * scattered changes) is transferred back.
  */
 template <typename T>
 class tBlackboardWriteAccess : public tBlackboardReadAccess<T>
@@ -94,9 +110,10 @@ public:
     tBase(blackboard, blackboard),
     locked_buffer_future(),
     locked_buffer(),
-    changed(false)
+    changed_range()
   {
     this->timeout = timeout;
+    this->write_locked_buffer = &locked_buffer;
     ConstructorImplementation(deferred_lock_check);
   }
 
@@ -112,20 +129,115 @@ public:
     tBase(blackboard.GetClient(), blackboard.GetClient()),
     locked_buffer_future(),
     locked_buffer(),
-    changed(false)
+    changed_range()
   {
     this->timeout = timeout;
+    this->write_locked_buffer = &locked_buffer;
     ConstructorImplementation(deferred_lock_check);
   }
 
+  /*!
+   * Acquires write access to range of shards only (see tBlackboardServer::SetShardCount()).
+   * Elements outside of these shards may be read (via GetConst()) - but not changed. Blackboard may not be resized.
+   *
+   * \param blackboard Blackboard to access
+   * \param first_shard Index of first shard to lock
+   * \param shard_count Number of shards to lock
+   * \param timeout Timeout for lock (in ms)
+   * \param deferred_lock_check If set to true, this constructor does not check whether lock could be
+   *                            acquired (and does not block). The lock is checked on the first access instead.
+   *
+   * \exception tLockException is thrown if lock fails (and deferred_lock_check is false)
+   */
+  tBlackboardWriteAccess(tBlackboardClient<T>& blackboard, size_t first_shard, size_t shard_count, const rrlib::time::tDuration& timeout = std::chrono::seconds(10), bool deferred_lock_check = false) :
+    tBase(blackboard, blackboard),
+    locked_buffer_future(),
+    locked_buffer(),
+    changed_range()
+  {
+    this->timeout = timeout;
+    this->write_locked_buffer = &locked_buffer;
+    ConstructorImplementation(deferred_lock_check, first_shard, shard_count);
+  }
+
+  /*!
+   * Acquires write access to range of shards only (see tBlackboardServer::SetShardCount()).
+   * Elements outside of these shards may be read (via GetConst()) - but not changed. Blackboard may not be resized.
+   *
+   * \param blackboard Blackboard to access
+   * \param first_shard Index of first shard to lock
+   * \param shard_count Number of shards to lock
+   * \param timeout Timeout for lock (in ms)
+   * \param deferred_lock_check If set to true, this constructor does not check whether lock could be
+   *                            acquired (and does not block). The lock is checked on the first access instead.
+   *
+   * \exception tLockException is thrown if lock fails (and deferred_lock_check is false)
+   */
+  tBlackboardWriteAccess(tBlackboard<T>& blackboard, size_t first_shard, size_t shard_count, const rrlib::time::tDuration& timeout = std::chrono::seconds(10), bool deferred_lock_check = false) :
+    tBase(blackboard.GetClient(), blackboard.GetClient()),
+    locked_buffer_future(),
+    locked_buffer(),
+    changed_range()
+  {
+    this->timeout = timeout;
+    this->write_locked_buffer = &locked_buffer;
+    ConstructorImplementation(deferred_lock_check, first_shard, shard_count);
+  }
+
+  /*!
+   * Acquires write access to range of elements only.
+   * Elements outside of this range may be read (via GetConst()) - but not changed. Blackboard may not be resized.
+   *
+   * \param blackboard Blackboard to access
+   * \param range Range of elements to lock
+   * \param timeout Timeout for lock (in ms)
+   * \param deferred_lock_check If set to true, this constructor does not check whether lock could be
+   *                            acquired (and does not block). The lock is checked on the first access instead.
+   *
+   * \exception tLockException is thrown if lock fails (and deferred_lock_check is false)
+   */
+  tBlackboardWriteAccess(tBlackboardClient<T>& blackboard, const tElementRange& range, const rrlib::time::tDuration& timeout = std::chrono::seconds(10), bool deferred_lock_check = false) :
+    tBase(blackboard, blackboard),
+    locked_buffer_future(),
+    locked_buffer(),
+    changed_range()
+  {
+    this->timeout = timeout;
+    this->write_locked_buffer = &locked_buffer;
+    ConstructorImplementation(deferred_lock_check, 0, 0, &range);
+  }
+
+  /*!
+   * Acquires write access to range of elements only.
+   * Elements outside of this range may be read (via GetConst()) - but not changed. Blackboard may not be resized.
+   *
+   * \param blackboard Blackboard to access
+   * \param range Range of elements to lock
+   * \param timeout Timeout for lock (in ms)
+   * \param deferred_lock_check If set to true, this constructor does not check whether lock could be
+   *                            acquired (and does not block). The lock is checked on the first access instead.
+   *
+   * \exception tLockException is thrown if lock fails (and deferred_lock_check is false)
+   */
+  tBlackboardWriteAccess(tBlackboard<T>& blackboard, const tElementRange& range, const rrlib::time::tDuration& timeout = std::chrono::seconds(10), bool deferred_lock_check = false) :
+    tBase(blackboard.GetClient(), blackboard.GetClient()),
+    locked_buffer_future(),
+    locked_buffer(),
+    changed_range()
+  {
+    this->timeout = timeout;
+    this->write_locked_buffer = &locked_buffer;
+    ConstructorImplementation(deferred_lock_check, 0, 0, &range);
+  }
+
   ~tBlackboardWriteAccess()
   {
     if (locked_buffer_raw)
     {
       FINROC_LOG_PRINT(DEBUG_VERBOSE_1, "Releasing write lock on blackboard '", blackboard.GetName(), "' at ", rrlib::time::Now());
-      if (changed)
+      if (!changed_range.IsEmpty())
       {
-        locked_buffer.CommitCurrentBuffer();
+        locked_buffer.CommitCurrentBuffer(changed_range);
       }
       else
       {
@@ -134,7 +246,7 @@ public:
     }
   }
 
-  inline T& operator[](size_t index)
+  inline typename std::vector<T>::reference operator[](size_t index)
   {
     return Get(index);
   }
@@ -145,15 +257,39 @@ public:
    *
    * \exception tLockException is thrown if lock fails (can only occur if locking was deferred in constructor)
    */
-  inline T& Get(size_t index)
+  inline typename std::vector<T>::reference Get(size_t index)
   {
     CheckLock();
     if (index >= locked_buffer_raw->size())
     {
       throw std::runtime_error("Blackboard write access out of bounds");
     }
-    changed = true;
-    return (*locked_buffer.Get())[index];
+    if (!locked_buffer.IsWritable(index))
+    {
+      throw std::runtime_error("Blackboard write access outside of locked range");
+    }
+    changed_range.Add(index);
+    return locked_buffer.GetElement(index);
+  }
+
+  /*!
+   * Read-only access to element.
+   * In contrast to Get(), this is also possible for elements outside of a locked range -
+   * and the element is not marked as changed.
+   *
+   * \param index Element index
+   * \return Element at index
+   *
+   * \exception tLockException is thrown if lock fails (can only occur if locking was deferred in constructor)
+   */
+  inline typename std::vector<T>::const_reference GetConst(size_t index)
+  {
+    CheckLock();
+    if (index >= locked_buffer_raw->size())
+    {
+      throw std::runtime_error("Blackboard read access out of bounds");
+    }
+    return locked_buffer.GetConstElement(index);
   }
 
   /*!
@@ -163,14 +299,33 @@ public:
    */
   inline void Resize(size_t new_size)
   {
-    if (new_size != this->Size())
+    size_t old_size = this->Size();
+    if (new_size != old_size)
     {
+      if (!locked_buffer.GetWritableRange().IsComplete())
+      {
+        throw std::runtime_error("Blackboard cannot be resized with write access to range only");
+      }
       rrlib::rtti::ResizeVector(*locked_buffer.Get(), new_size);
-      changed = true;
+      changed_range.Add(std::min(old_size, new_size), std::max(old_size, new_size));
       locked_buffer_raw = locked_buffer.Get();
     }
   }
 
+  /*!
+   * Renews lease of remote write lock (see tBlackboardServer::SetLockLeaseDuration()).
+   * Should be called regularly if write access is held longer than the server's lease duration -
+   * otherwise, the lock is revoked and changes are discarded on commit.
+   * Has no effect if lock has not been acquired yet.
+   */
+  void KeepAlive()
+  {
+    if (locked_buffer_raw)
+    {
+      blackboard.RenewLockLease(locked_buffer.GetLockId());
+    }
+  }
+
   /*!
    * \return Number of elements in blackboard
    *
@@ -199,8 +354,8 @@ private:
   /*! Buffer from locked blackboard */
   internal::tLockedBuffer<tBuffer> locked_buffer;
 
-  /*! True as soon as changes have been made to buffer */
-  bool changed;
+  /*! Range of elements that were changed (possibly) - empty as long as no changes have been made to buffer */
+  internal::tChangedRange changed_range;
 
 
   /*!
@@ -224,16 +379,28 @@ private:
   }
 
   /*!
-   * Code that would be identical in both constructors
+   * Code that would be identical in all constructors
+   *
+   * \param deferred_lock_check Defer lock check to first access?
+   * \param first_shard Index of first shard to lock
+   * \param shard_count Number of shards to lock (0 to lock whole blackboard)
+   * \param range Range of elements to lock (NULL to lock whole blackboard or shards)
    */
-  void ConstructorImplementation(bool deferred_lock_check)
+  void ConstructorImplementation(bool deferred_lock_check, size_t first_shard = 0, size_t shard_count = 0, const tElementRange* range = NULL)
   {
     if (!this->blackboard)
     {
       throw tLockException(rpc_ports::tFutureStatus::INVALID_CALL);
     }
     FINROC_LOG_PRINT(DEBUG_VERBOSE_1, "Acquiring write lock on blackboard '", blackboard.GetName(), "' at ", rrlib::time::Now());
-    locked_buffer_future = this->blackboard.WriteLock(timeout);
+    if (range)
+    {
+      locked_buffer_future = this->blackboard.WriteLock(*range, timeout);
+    }
+    else
+    {
+      locked_buffer_future = shard_count ? this->blackboard.ShardWriteLock(first_shard, shard_count, timeout) : this->blackboard.WriteLock(timeout);
+    }
     if (!deferred_lock_check)
     {
       CheckLock();
@@ -42,10 +42,14 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "plugins/blackboard/definitions.h"
+#include "plugins/blackboard/internal/tChangeSetCodec.h"
+#include "plugins/blackboard/internal/tElementOperations.h"
 
 //----------------------------------------------------------------------
 // Namespace declaration
@@ -64,10 +68,18 @@ namespace blackboard
 //----------------------------------------------------------------------
 //! Change to blackboard
 /*!
- * Change to blackboard element.
+ * Change to blackboard element - or to a range of consecutive elements.
  * Such changes can be packed as change sets to perform atomic
  * changes to blackboards asynchronously.
+ * Single-element and range changes may be mixed freely in a change set.
+ * Structural changes (append, insert, erase, truncate, resize - see static factory functions)
+ * allow to change the size of list-like blackboards without acquiring a write lock.
+ * Atomic operations (add, min, max, bitwise or, compare-and-swap) modify single elements
+ * based on their current value - e.g. for counters and accumulators.
+ * Changes in a change set are applied in order.
  * The template may be specialized for certain blackboard content types.
+ * For trivially copyable content types, changes are moved and applied
+ * by plain copies instead of swaps.
  */
 template <typename T>
 class tChange : public rrlib::util::tNoncopyable
@@ -78,7 +90,13 @@ class tChange : public rrlib::util::tNoncopyable
 //----------------------------------------------------------------------
 public:
 
-  tChange() : index(-1), new_element(rrlib::serialization::DefaultInstantiation<T>::Create()) {}
+  tChange() :
+    index(-1),
+    operation(tChangeOperation::REPLACE),
+    count(0),
+    new_element(rrlib::serialization::DefaultInstantiation<T>::Create()),
+    new_elements()
+  {}
 
   /*!
    * \param index Index of element in blackboard to change
@@ -86,51 +104,400 @@ public:
    */
   tChange(size_t index, T new_element) :
     index(index),
-    new_element(new_element)
+    operation(tChangeOperation::REPLACE),
+    count(0),
+    new_element(new_element),
+    new_elements()
+  {}
+
+  /*!
+   * Creates change that replaces range of consecutive elements
+   *
+   * \param start Index of first element in blackboard to replace
+   * \param new_elements New elements to place at indices [start, start + new_elements.size())
+   */
+  tChange(size_t start, std::vector<T> && new_elements) :
+    index(start),
+    operation(tChangeOperation::REPLACE_RANGE),
+    count(0),
+    new_element(rrlib::serialization::DefaultInstantiation<T>::Create()),
+    new_elements(std::move(new_elements))
   {}
 
+  /*!
+   * Creates change that replaces range of consecutive elements
+   *
+   * \param start Index of first element in blackboard to replace
+   * \param source Contiguous source of new elements
+   * \param count Number of elements to replace
+   */
+  tChange(size_t start, const T* source, size_t count) :
+    index(start),
+    operation(tChangeOperation::REPLACE_RANGE),
+    count(0),
+    new_element(rrlib::serialization::DefaultInstantiation<T>::Create()),
+    new_elements()
+  {
+    rrlib::rtti::ResizeVector(new_elements, count);
+    internal::tElementOperations<T>::Copy(source, new_elements, 0, count);
+  }
+
   /*! move constructor */
-  tChange(tChange && other) : index(-1), new_element(rrlib::serialization::DefaultInstantiation<T>::Create())
+  tChange(tChange && other) :
+    index(-1),
+    operation(tChangeOperation::REPLACE),
+    count(0),
+    new_element(rrlib::serialization::DefaultInstantiation<T>::Create()),
+    new_elements()
   {
-    std::swap(index, other.index);
-    std::swap(new_element, other.new_element);
+    MoveFrom(other, internal::tIsTriviallyCopyable<T>());
   }
 
   /*! move assignment */
   tChange& operator=(tChange && other)
   {
-    std::swap(index, other.index);
-    std::swap(new_element, other.new_element);
+    MoveFrom(other, internal::tIsTriviallyCopyable<T>());
     return *this;
   }
 
+  /*!
+   * \param index Index of element to change
+   * \param operand Operand to add to element
+   * \return Change that adds operand to element (atomic operation)
+   */
+  static tChange Add(size_t index, T operand)
+  {
+    return AtomicOperation(tChangeOperation::ADD, index, operand);
+  }
+
+  /*!
+   * \param new_elements Elements to append to blackboard
+   * \return Change that appends elements to blackboard
+   */
+  static tChange Append(std::vector<T> && new_elements)
+  {
+    tChange change(tChangeOperation::APPEND, 0, 0);
+    change.new_elements = std::move(new_elements);
+    return change;
+  }
+
+  /*!
+   * \param new_element Element to append to blackboard
+   * \return Change that appends element to blackboard
+   */
+  static tChange Append(T new_element)
+  {
+    tChange change(tChangeOperation::APPEND, 0, 0);
+    rrlib::rtti::ResizeVector(change.new_elements, 1);
+    internal::tElementOperations<T>::Swap(change.new_elements, 0, new_element);
+    return change;
+  }
+
+  /*!
+   * \param index Index of element to change
+   * \param operand Operand
+   * \return Change that combines element with operand using bitwise or (atomic operation)
+   */
+  static tChange BitwiseOr(size_t index, T operand)
+  {
+    return AtomicOperation(tChangeOperation::BITWISE_OR, index, operand);
+  }
+
+  /*!
+   * \param index Index of element to change
+   * \param expected Expected value of element
+   * \param new_element Value to replace element with - if it equals the expected value
+   * \return Change that replaces element if it has the expected value (atomic operation)
+   */
+  static tChange CompareAndSwap(size_t index, T expected, T new_element)
+  {
+    tChange change = AtomicOperation(tChangeOperation::COMPARE_AND_SWAP, index, new_element);
+    rrlib::rtti::ResizeVector(change.new_elements, 1);
+    internal::tElementOperations<T>::Swap(change.new_elements, 0, expected);
+    return change;
+  }
+
+  /*!
+   * \param index Index of first element to erase
+   * \param count Number of elements to erase (clipped to blackboard size)
+   * \return Change that erases elements from blackboard (subsequent elements move forward)
+   */
+  static tChange Erase(size_t index, size_t count = 1)
+  {
+    return tChange(tChangeOperation::ERASE, index, count);
+  }
+
+  /*!
+   * \param index Index to insert elements at (may be blackboard size)
+   * \param new_elements Elements to insert
+   * \return Change that inserts elements into blackboard (subsequent elements move back)
+   */
+  static tChange Insert(size_t index, std::vector<T> && new_elements)
+  {
+    tChange change(tChangeOperation::INSERT, index, 0);
+    change.new_elements = std::move(new_elements);
+    return change;
+  }
+
+  /*!
+   * \param index Index to insert element at (may be blackboard size)
+   * \param new_element Element to insert
+   * \return Change that inserts element into blackboard (subsequent elements move back)
+   */
+  static tChange Insert(size_t index, T new_element)
+  {
+    tChange change(tChangeOperation::INSERT, index, 0);
+    rrlib::rtti::ResizeVector(change.new_elements, 1);
+    internal::tElementOperations<T>::Swap(change.new_elements, 0, new_element);
+    return change;
+  }
+
+  /*!
+   * \param index Index of element to change
+   * \param operand Operand
+   * \return Change that replaces element with operand if operand is larger (atomic operation)
+   */
+  static tChange Max(size_t index, T operand)
+  {
+    return AtomicOperation(tChangeOperation::MAX, index, operand);
+  }
+
+  /*!
+   * \param index Index of element to change
+   * \param operand Operand
+   * \return Change that replaces element with operand if operand is smaller (atomic operation)
+   */
+  static tChange Min(size_t index, T operand)
+  {
+    return AtomicOperation(tChangeOperation::MIN, index, operand);
+  }
+
+  /*!
+   * \param size New blackboard size
+   * \return Change that resizes blackboard (new elements are default-constructed)
+   */
+  static tChange Resize(size_t size)
+  {
+    return tChange(tChangeOperation::RESIZE, 0, size);
+  }
+
+  /*!
+   * \param size Maximum blackboard size
+   * \return Change that removes all elements from blackboard that exceed the specified size
+   */
+  static tChange Truncate(size_t size)
+  {
+    return tChange(tChangeOperation::TRUNCATE, 0, size);
+  }
+
+  /*!
+   * \return Number of elements that are replaced, inserted or erased - or new blackboard size (TRUNCATE, RESIZE)
+   */
+  size_t GetElementCount() const
+  {
+    switch (operation)
+    {
+    case tChangeOperation::REPLACE_RANGE:
+    case tChangeOperation::APPEND:
+    case tChangeOperation::INSERT:
+      return new_elements.size();
+    case tChangeOperation::ERASE:
+    case tChangeOperation::TRUNCATE:
+    case tChangeOperation::RESIZE:
+      return count;
+    default:
+      return 1;
+    }
+  }
+
+  /*!
+   * \return Index of (first) element in blackboard to change (negative if change is empty)
+   */
+  int GetIndex() const
+  {
+    return index;
+  }
+
+  /*!
+   * \return Operation performed by this change
+   */
+  tChangeOperation GetOperation() const
+  {
+    return operation;
+  }
+
+  /*!
+   * After an atomic operation was applied, it contains the previous value of the changed element.
+   *
+   * \return Previous value of element (atomic operations only - after Apply())
+   */
+  const T& GetPreviousElement() const
+  {
+    return new_element;
+  }
+
+  /*!
+   * \return True if change is an atomic operation on a single element (add, min, max, bitwise or, compare-and-swap)
+   */
+  bool IsAtomicOperation() const
+  {
+    return operation >= tChangeOperation::ADD;
+  }
+
+  /*!
+   * \return True if change may change the size of the blackboard
+   */
+  bool IsStructural() const
+  {
+    return operation >= tChangeOperation::APPEND && operation <= tChangeOperation::RESIZE;
+  }
+
   /*!
    * Applies change to blackboard buffer
+   * (range changes are applied in bulk - with memcpy for trivially copyable elements)
+   *
+   * Atomic operations are evaluated on the current value of the element. Afterwards, the change contains
+   * the previous value of the element (see GetPreviousElement()).
    *
    * \param blackboard_buffer Blackboard buffer to apply change to
+   * \return Range of indices whose elements were changed, inserted or removed (empty if change was not applied)
    */
-  void Apply(std::vector<T>& blackboard_buffer)
+  tElementRange Apply(std::vector<T>& blackboard_buffer)
   {
-    if (index > static_cast<int>(blackboard_buffer.size()))
+    size_t size = blackboard_buffer.size();
+    if (index < 0)
     {
-      FINROC_LOG_PRINTF_STATIC(WARNING, "Blackboard change has index (%d) out of bounds (%d). Ignoring.", index, static_cast<int>(blackboard_buffer.size()));
+      return tElementRange(0, 0);
     }
-    else if (index >= 0)
+    switch (operation)
     {
-      std::swap(blackboard_buffer[index], new_element);
+    case tChangeOperation::REPLACE:
+    case tChangeOperation::REPLACE_RANGE:
+      if (index + GetElementCount() > size)
+      {
+        FINROC_LOG_PRINTF_STATIC(WARNING, "Blackboard change has index (%d, %d elements) out of bounds (%d). Ignoring.", index, static_cast<int>(GetElementCount()), static_cast<int>(size));
+        return tElementRange(0, 0);
+      }
+      if (operation == tChangeOperation::REPLACE_RANGE)
+      {
+        internal::tElementOperations<T>::Move(new_elements, 0, blackboard_buffer, index, new_elements.size());
+      }
+      else
+      {
+        Place(blackboard_buffer, index, internal::tIsTriviallyCopyable<T>());
+      }
+      return tElementRange(index, index + GetElementCount());
+
+    case tChangeOperation::APPEND:
+      InsertElements(blackboard_buffer, size);
+      return tElementRange(size, blackboard_buffer.size());
+
+    case tChangeOperation::INSERT:
+      if (static_cast<size_t>(index) > size)
+      {
+        FINROC_LOG_PRINTF_STATIC(WARNING, "Blackboard change inserts at index (%d) out of bounds (%d). Ignoring.", index, static_cast<int>(size));
+        return tElementRange(0, 0);
+      }
+      InsertElements(blackboard_buffer, index);
+      return tElementRange(index, blackboard_buffer.size());
+
+    case tChangeOperation::ERASE:
+      if (static_cast<size_t>(index) >= size)
+      {
+        FINROC_LOG_PRINTF_STATIC(WARNING, "Blackboard change erases at index (%d) out of bounds (%d). Ignoring.", index, static_cast<int>(size));
+        return tElementRange(0, 0);
+      }
+      {
+        size_t erase_count = std::min(count, size - index);
+        std::move(blackboard_buffer.begin() + index + erase_count, blackboard_buffer.end(), blackboard_buffer.begin() + index);
+        rrlib::rtti::ResizeVector(blackboard_buffer, size - erase_count);
+      }
+      return tElementRange(index, size);
+
+    case tChangeOperation::TRUNCATE:
+      if (count >= size)
+      {
+        return tElementRange(0, 0);
+      }
+      rrlib::rtti::ResizeVector(blackboard_buffer, count);
+      return tElementRange(count, size);
+
+    case tChangeOperation::RESIZE:
+      rrlib::rtti::ResizeVector(blackboard_buffer, count);
+      return tElementRange(std::min(size, count), std::max(size, count));
+
+    default:
+      if (static_cast<size_t>(index) >= size)
+      {
+        FINROC_LOG_PRINTF_STATIC(WARNING, "Blackboard change has index (%d) out of bounds (%d). Ignoring.", index, static_cast<int>(size));
+        return tElementRange(0, 0);
+      }
+      return ApplyAtomicOperation(blackboard_buffer, index) ? tElementRange(index, index + 1) : tElementRange(0, 0);
     }
   }
 
   void Deserialize(rrlib::serialization::tInputStream& stream)
   {
     index = stream.ReadInt();
-    stream >> new_element;
+    operation = static_cast<tChangeOperation>(stream.ReadByte());
+    switch (operation)
+    {
+    case tChangeOperation::REPLACE:
+    case tChangeOperation::ADD:
+    case tChangeOperation::MIN:
+    case tChangeOperation::MAX:
+    case tChangeOperation::BITWISE_OR:
+      stream >> new_element;
+      break;
+    case tChangeOperation::COMPARE_AND_SWAP:
+      rrlib::rtti::ResizeVector(new_elements, 1);
+      stream >> new_element;
+      internal::tElementOperations<T>::Deserialize(stream, new_elements, 0, 1);
+      break;
+    case tChangeOperation::REPLACE_RANGE:
+    case tChangeOperation::APPEND:
+    case tChangeOperation::INSERT:
+    {
+      size_t element_count = static_cast<size_t>(stream.ReadLong());
+      if (new_elements.size() != element_count)
+      {
+        rrlib::rtti::ResizeVector(new_elements, element_count);
+      }
+      internal::tElementOperations<T>::Deserialize(stream, new_elements, 0, element_count);
+      break;
+    }
+    default:
+      count = static_cast<size_t>(stream.ReadLong());
+      break;
+    }
   }
 
   void Serialize(rrlib::serialization::tOutputStream& stream) const
   {
     stream.WriteInt(index);
-    stream << new_element;
+    stream.WriteByte(static_cast<int8_t>(operation));
+    switch (operation)
+    {
+    case tChangeOperation::REPLACE:
+    case tChangeOperation::ADD:
+    case tChangeOperation::MIN:
+    case tChangeOperation::MAX:
+    case tChangeOperation::BITWISE_OR:
+      stream << new_element;
+      break;
+    case tChangeOperation::COMPARE_AND_SWAP:
+      stream << new_element << new_elements[0];
+      break;
+    case tChangeOperation::REPLACE_RANGE:
+    case tChangeOperation::APPEND:
+    case tChangeOperation::INSERT:
+      stream.WriteLong(static_cast<int64_t>(new_elements.size()));
+      internal::tElementOperations<T>::Serialize(stream, new_elements, 0, new_elements.size());
+      break;
+    default:
+      stream.WriteLong(static_cast<int64_t>(count));
+      break;
+    }
   }
 
 //----------------------------------------------------------------------
@@ -138,11 +505,133 @@ public:
 //----------------------------------------------------------------------
 private:
 
-  /*! Index of element in blackboard to change */
+  friend class internal::tChangeSetCodec<T>;
+
+  /*! Index of (first) element in blackboard to change */
   int index;
 
-  /*! New element to place at this index */
+  /*! Operation performed by this change */
+  tChangeOperation operation;
+
+  /*! Number of elements to erase (ERASE) - or new blackboard size (TRUNCATE, RESIZE) */
+  size_t count;
+
+  /*! New element to place at this index (operations REPLACE, COMPARE_AND_SWAP) - or operand (other atomic operations) */
   T new_element;
+
+  /*! New elements to place at consecutive indices starting at index (operations REPLACE_RANGE, APPEND, INSERT) - or expected element (COMPARE_AND_SWAP) */
+  std::vector<T> new_elements;
+
+  tChange(tChangeOperation operation, size_t index, size_t count) :
+    index(index),
+    operation(operation),
+    count(count),
+    new_element(rrlib::serialization::DefaultInstantiation<T>::Create()),
+    new_elements()
+  {}
+
+  /*!
+   * Applies atomic operation to element
+   *
+   * \param blackboard_buffer Blackboard buffer
+   * \param element_index Index of element to apply operation to
+   * \return False if element type does not support this operation - or compare-and-swap failed (element was not changed)
+   */
+  bool ApplyAtomicOperation(std::vector<T>& blackboard_buffer, size_t element_index)
+  {
+    T element(blackboard_buffer[element_index]);
+    bool supported = true;
+    bool swapped = true;
+    switch (operation)
+    {
+    case tChangeOperation::ADD:
+      supported = internal::tElementOperations<T>::Add(element, new_element);
+      break;
+    case tChangeOperation::MIN:
+      supported = internal::tElementOperations<T>::Min(element, new_element);
+      break;
+    case tChangeOperation::MAX:
+      supported = internal::tElementOperations<T>::Max(element, new_element);
+      break;
+    case tChangeOperation::BITWISE_OR:
+      supported = internal::tElementOperations<T>::BitwiseOr(element, new_element);
+      break;
+    default:
+      swapped = rrlib::rtti::GenericOperations<T>::Equals(element, new_elements[0]);
+      if (swapped)
+      {
+        std::swap(element, new_element);
+      }
+      break;
+    }
+    if (!supported)
+    {
+      FINROC_LOG_PRINTF_STATIC(WARNING, "Blackboard change operation (%d) is not supported by element type. Ignoring.", static_cast<int>(operation));
+      return false;
+    }
+    if (swapped)
+    {
+      internal::tElementOperations<T>::Swap(blackboard_buffer, element_index, element);  // element now holds previous value
+    }
+    std::swap(new_element, element);
+    return swapped;
+  }
+
+  /*!
+   * \param operation Atomic operation
+   * \param index Index of element to change
+   * \param operand Operand
+   * \return Change with atomic operation
+   */
+  static tChange AtomicOperation(tChangeOperation operation, size_t index, T& operand)
+  {
+    tChange change(operation, index, 0);
+    std::swap(change.new_element, operand);
+    return change;
+  }
+
+  /*!
+   * Inserts new_elements into blackboard buffer
+   *
+   * \param blackboard_buffer Blackboard buffer
+   * \param position Index to insert elements at
+   */
+  void InsertElements(std::vector<T>& blackboard_buffer, size_t position)
+  {
+    size_t size = blackboard_buffer.size();
+    rrlib::rtti::ResizeVector(blackboard_buffer, size + new_elements.size());
+    std::move_backward(blackboard_buffer.begin() + position, blackboard_buffer.begin() + size, blackboard_buffer.end());
+    internal::tElementOperations<T>::Move(new_elements, 0, blackboard_buffer, position, new_elements.size());
+  }
+
+  void MoveFrom(tChange& other, std::true_type)
+  {
+    index = other.index;
+    operation = other.operation;
+    count = other.count;
+    new_element = other.new_element;
+    std::swap(new_elements, other.new_elements);
+    other.index = -1;
+  }
+
+  void MoveFrom(tChange& other, std::false_type)
+  {
+    std::swap(index, other.index);
+    std::swap(operation, other.operation);
+    std::swap(count, other.count);
+    std::swap(new_element, other.new_element);
+    std::swap(new_elements, other.new_elements);
+  }
+
+  void Place(std::vector<T>& blackboard_buffer, size_t element_index, std::true_type)
+  {
+    blackboard_buffer[element_index] = new_element;
+  }
+
+  void Place(std::vector<T>& blackboard_buffer, size_t element_index, std::false_type)
+  {
+    internal::tElementOperations<T>::Swap(blackboard_buffer, element_index, new_element);
+  }
 };
 
 template <typename T>
@@ -159,6 +648,23 @@ rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStr
   return stream;
 }
 
+/*!
+ * Change sets are serialized in compact form (see internal::tChangeSetCodec)
+ */
+template <typename T>
+rrlib::serialization::tOutputStream& operator << (rrlib::serialization::tOutputStream& stream, const std::vector<tChange<T>>& change_set)
+{
+  internal::tChangeSetCodec<T>::Serialize(stream, change_set);
+  return stream;
+}
+
+template <typename T>
+rrlib::serialization::tInputStream& operator >> (rrlib::serialization::tInputStream& stream, std::vector<tChange<T>>& change_set)
+{
+  internal::tChangeSetCodec<T>::Deserialize(stream, change_set);
+  return stream;
+}
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
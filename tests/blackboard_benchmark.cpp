@@ -0,0 +1,320 @@
+//
+// You received this file as part of Finroc
+// A framework for intelligent robot control
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    plugins/blackboard/tests/blackboard_benchmark.cpp
+ *
+ * \author  Max Reichardt
+ *
+ * \date    2026-10-17
+ *
+ * Measures throughput of blackboard operations.
+ *
+ * Read lock throughput is measured for 1 to N concurrent reader threads -
+ * with lock-free read locks and with the mutex-based read path.
+ *
+ * Copying, applying changes and serializing elements is measured for
+ * different element types and blackboard sizes - with the fast paths for
+ * trivially copyable elements and with generic per-element code.
+ *
+ * Compression codecs are compared regarding CPU time and bytes saved
+ * for representative blackboard contents.
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "core/tRuntimeEnvironment.h"
+#include "rrlib/serialization/serialization.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "plugins/blackboard/internal/tBlackboardServer.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace finroc::blackboard;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+/*! Duration of each measurement */
+const rrlib::time::tDuration cMEASUREMENT_DURATION = std::chrono::milliseconds(500);
+
+/*! Number of elements in benchmark blackboards */
+const size_t cBLACKBOARD_ELEMENTS = 20;
+
+/*! Blackboard sizes for element operation benchmarks */
+const size_t cELEMENT_BENCHMARK_SIZES[] = { 20, 1000, 100000 };
+
+/*! Trivially copyable struct element type */
+struct tPose
+{
+  double x, y, z, yaw;
+
+  bool operator==(const tPose& other) const
+  {
+    return x == other.x && y == other.y && z == other.z && yaw == other.yaw;
+  }
+};
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Measures read lock throughput
+ *
+ * \param server Blackboard server to read-lock
+ * \param threads Number of concurrent reader threads
+ * \return Read locks per second (all threads)
+ */
+template <typename T>
+double MeasureReadLockThroughput(internal::tBlackboardServer<T>& server, size_t threads)
+{
+  std::atomic<bool> stop(false);
+  std::atomic<uint64_t> total_read_locks(0);
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < threads; i++)
+  {
+    readers.emplace_back([&]()
+    {
+      uint64_t read_locks = 0;
+      while (!stop.load(std::memory_order_relaxed))
+      {
+        auto buffer = server.ReadLock(std::chrono::seconds(1)).Get(std::chrono::seconds(1));
+        assert(buffer->size() == cBLACKBOARD_ELEMENTS);
+        read_locks++;
+      }
+      total_read_locks += read_locks;
+    });
+  }
+  std::this_thread::sleep_for(cMEASUREMENT_DURATION);
+  stop = true;
+  for (auto & reader : readers)
+  {
+    reader.join();
+  }
+  return total_read_locks / std::chrono::duration_cast<std::chrono::duration<double>>(cMEASUREMENT_DURATION).count();
+}
+
+/*!
+ * Runs function repeatedly for cMEASUREMENT_DURATION
+ *
+ * \param function Function to run
+ * \return Average duration of one run in nanoseconds
+ */
+template <typename TFunction>
+double MeasureNanoseconds(TFunction function)
+{
+  size_t runs = 0;
+  rrlib::time::tTimestamp start = rrlib::time::Now();
+  rrlib::time::tTimestamp end = start;
+  while (end - start < cMEASUREMENT_DURATION)
+  {
+    function();
+    runs++;
+    end = rrlib::time::Now();
+  }
+  return std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(end - start).count() / runs;
+}
+
+/*!
+ * Measures copying blackboard buffers and applying changes -
+ * with fast paths and with generic per-element code
+ *
+ * \param type_name Name of element type to print
+ */
+template <typename T>
+void BenchmarkElementOperations(const std::string& type_name)
+{
+  for (size_t size : cELEMENT_BENCHMARK_SIZES)
+  {
+    std::vector<T> source(size), target(size), new_elements(size);
+    double generic_copy = MeasureNanoseconds([&]()
+    {
+      for (size_t i = 0; i < size; i++)
+      {
+        rrlib::rtti::GenericOperations<T>::DeepCopy(source[i], target[i]);
+      }
+    });
+    double fast_copy = MeasureNanoseconds([&]()
+    {
+      internal::tElementOperations<T>::Copy(source, 0, target, 0, size);
+    });
+
+    std::vector<tChange<T>> changes;
+    for (size_t i = 0; i < size; i++)
+    {
+      changes.emplace_back(i, new_elements[i]);
+    }
+    double generic_apply = MeasureNanoseconds([&]()
+    {
+      for (size_t i = 0; i < size; i++)
+      {
+        std::swap(target[i], new_elements[i]);
+      }
+    });
+    double fast_apply = MeasureNanoseconds([&]()
+    {
+      for (auto & change : changes)
+      {
+        change.Apply(target);
+      }
+    });
+    std::cout << type_name << "  " << size << "  " << generic_copy << "  " << fast_copy << "  " << generic_apply << "  " << fast_apply << std::endl;
+  }
+}
+
+/*!
+ * Measures serializing blackboard elements - in bulk and one by one
+ *
+ * \param type_name Name of element type to print
+ */
+template <typename T>
+void BenchmarkElementSerialization(const std::string& type_name)
+{
+  for (size_t size : cELEMENT_BENCHMARK_SIZES)
+  {
+    std::vector<T> elements(size);
+    rrlib::serialization::tMemoryBuffer memory_buffer(size * sizeof(T) + 64);
+    double generic_serialization = MeasureNanoseconds([&]()
+    {
+      rrlib::serialization::tOutputStream stream(memory_buffer);
+      for (size_t i = 0; i < size; i++)
+      {
+        stream << elements[i];
+      }
+    });
+    double bulk_serialization = MeasureNanoseconds([&]()
+    {
+      rrlib::serialization::tOutputStream stream(memory_buffer);
+      internal::tElementOperations<T>::Serialize(stream, elements, 0, size);
+    });
+    std::cout << type_name << "  " << size << "  " << generic_serialization << "  " << bulk_serialization << std::endl;
+  }
+}
+
+/*!
+ * Measures compressing and decompressing blackboard elements with all codecs
+ *
+ * \param content_name Name of blackboard content to print
+ * \param generator Function that returns element with specified index
+ */
+template <typename T, typename TGenerator>
+void BenchmarkCompression(const std::string& content_name, TGenerator generator)
+{
+  for (size_t size : cELEMENT_BENCHMARK_SIZES)
+  {
+    std::vector<T> elements(size), decompressed(size);
+    for (size_t i = 0; i < size; i++)
+    {
+      elements[i] = generator(i);
+    }
+    const uint8_t* input = reinterpret_cast<const uint8_t*>(elements.data());
+    size_t input_size = size * sizeof(T);
+    for (tCompression compression : { tCompression::LZ, tCompression::SHUFFLE_DELTA_LZ })
+    {
+      std::vector<uint8_t> compressed;
+      double compress = MeasureNanoseconds([&]()
+      {
+        internal::tCompressionCodec::Compress(input, input_size, sizeof(T), compression, compressed);
+      });
+      double decompress = MeasureNanoseconds([&]()
+      {
+        internal::tCompressionCodec::Decompress(compressed.data(), compressed.size(), sizeof(T), compression,
+                                                reinterpret_cast<uint8_t*>(decompressed.data()), input_size);
+      });
+      assert(decompressed == elements);
+      std::cout << content_name << "  " << size << "  " << (compression == tCompression::LZ ? "LZ" : "Shuffle-delta-LZ") << "  " << input_size << "  " <<
+                compressed.size() << "  " << compress << "  " << decompress << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  finroc::core::tFrameworkElement* parent = new finroc::core::tFrameworkElement(&finroc::core::tRuntimeEnvironment::GetInstance(), "Benchmark");
+  internal::tBlackboardServer<float>* float_server = new internal::tBlackboardServer<float>("Float Blackboard", parent, false, cBLACKBOARD_ELEMENTS, false);
+  finroc::core::tRuntimeEnvironment::GetInstance().InitAll();
+
+  size_t max_threads = std::max<size_t>(2, std::thread::hardware_concurrency());
+  std::cout << "Read lock throughput (read locks/s)" << std::endl;
+  std::cout << "Threads  Lock-free  Mutex" << std::endl;
+  for (size_t threads = 1; threads <= max_threads; threads++)
+  {
+    float_server->SetLockFreeReadsEnabled(true);
+    double lock_free = MeasureReadLockThroughput(*float_server, threads);
+    float_server->SetLockFreeReadsEnabled(false);
+    double mutex = MeasureReadLockThroughput(*float_server, threads);
+    std::cout << threads << "  " << lock_free << "  " << mutex << std::endl;
+  }
+  float_server->SetLockFreeReadsEnabled(true);
+
+  std::cout << std::endl << "Copy and apply (ns per buffer)" << std::endl;
+  std::cout << "Type  Elements  Generic-copy  Fast-copy  Generic-apply  Fast-apply" << std::endl;
+  BenchmarkElementOperations<float>("float");
+  BenchmarkElementOperations<tPose>("tPose");
+
+  std::cout << std::endl << "Serialization (ns per buffer)" << std::endl;
+  std::cout << "Type  Elements  Per-element  Bulk" << std::endl;
+  BenchmarkElementSerialization<float>("float");
+  BenchmarkElementSerialization<double>("double");
+
+  std::cout << std::endl << "Compression (ns per buffer)" << std::endl;
+  std::cout << "Content  Elements  Codec  Bytes  Compressed-bytes  Compress  Decompress" << std::endl;
+  std::mt19937 random_engine(42);
+  BenchmarkCompression<float>("smooth-float", [](size_t i)
+  {
+    return static_cast<float>(std::sin(i * 0.01));
+  });
+  BenchmarkCompression<float>("sparse-float", [&](size_t i)
+  {
+    return random_engine() % 16 ? 0.f : 1.f;
+  });
+  BenchmarkCompression<int32_t>("counter-int32", [](size_t i)
+  {
+    return static_cast<int32_t>(i * 3);
+  });
+  BenchmarkCompression<double>("noise-double", [&](size_t i)
+  {
+    return std::uniform_real_distribution<double>()(random_engine);
+  });
+
+  parent->ManagedDelete();
+  return 0;
+}
@@ -33,13 +33,16 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include "rrlib/util/tUnitTestSuite.h"
+#include "rrlib/serialization/serialization.h"
 #include "core/tRuntimeEnvironment.h"
 #include "plugins/structure/tTopLevelThreadContainer.h"
+#include <thread>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
 #include "plugins/blackboard/tBlackboard.h"
+#include "plugins/blackboard/internal/tRemoteBlackboardServer.h"
 #include "plugins/blackboard/tests/mBlackboardReader.h"
 #include "plugins/blackboard/tests/mBlackboardWriter.h"
 #include "plugins/blackboard/tests/mBlackboardWriterAsync.h"
@@ -133,12 +136,49 @@ public:
   }
 };
 
+/*! Trivially copyable element type (for tests of element operations) */
+struct tTestPoint
+{
+  int x;
+  double y;
+
+  bool operator==(const tTestPoint& other) const
+  {
+    return x == other.x && y == other.y;
+  }
+};
+
 structure::tTopLevelThreadContainer<>* main_thread;
 
 class BlackboardTest : public rrlib::util::tUnitTestSuite
 {
   RRLIB_UNIT_TESTS_BEGIN_SUITE(BlackboardTest);
   RRLIB_UNIT_TESTS_ADD_TEST(TestBlackboardOperations);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChunkedCopyOnWrite);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBufferReuse);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestDeltaPublishing);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestShardWriteLocks);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestOptimisticCommit);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestRevisionRetention);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestAdaptiveBufferMode);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestPublishingPolicies);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLockRequestQueue);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLockLeases);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestElementOperations);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestBoolBlackboard);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestTripleBuffering);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestSeqlockReads);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestLockFreeReads);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChangeSetEncoding);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestRangeChanges);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChangeCoalescing);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChangedRangeTracking);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestChangedRangeSerialization);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestStructuralChanges);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestAtomicOperations);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestReadDelta);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestCompression);
+  RRLIB_UNIT_TESTS_ADD_TEST(TestRemoteReplica);
   RRLIB_UNIT_TESTS_ADD_TEST(TestBlackboardConnecting);
   RRLIB_UNIT_TESTS_END_SUITE;
 
@@ -187,6 +227,1094 @@ class BlackboardTest : public rrlib::util::tUnitTestSuite
     }
   }
 
+  void TestChunkedCopyOnWrite()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestChunkedCopyOnWrite");
+
+    // create multi-buffered float blackboard with capacity 20 and chunks of 4 elements
+    // (multi-buffered mode is fixed, as writers in single-buffered mode lock the buffer exclusively instead of copying)
+    tBlackboard<float> blackboard("Chunked Float Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetBufferMode(tBufferMode::MULTI_BUFFERED, false);
+    blackboard.SetChunkedCopyOnWrite(4);
+    tBlackboardClient<float>& client = blackboard.GetClient();
+    main_thread->Init();
+
+    // Writer changing elements in two chunks only copies and commits these two chunks
+    tBlackboardClient<float>::tConstBufferPointer old_content = client.ReadLock().Get(std::chrono::seconds(2));
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[1] = 1;
+      write_access[2] = 2;
+      write_access[13] = 3;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetStatistics().committed_chunks == 2);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access.Size() == 20 && read_access[0] == 0 && read_access[1] == 1 && read_access[2] == 2 && read_access[12] == 0 && read_access[13] == 3);
+    }
+    RRLIB_UNIT_TESTS_ASSERT((*old_content)[1] == 0 && (*old_content)[13] == 0);  // buffer locked by reader is not modified
+    old_content.Reset();
+
+    // Resizing copies the complete buffer (modified chunks are moved to copy)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[5] = 4;
+      write_access.Resize(24);
+      write_access[22] = 5;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetStatistics().committed_chunks == 2);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access.Size() == 24 && read_access[1] == 1 && read_access[5] == 4 && read_access[13] == 3 && read_access[22] == 5);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestBufferReuse()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestBufferReuse");
+    tBlackboard<float> blackboard("Recycling Float Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetBufferMode(tBufferMode::MULTI_BUFFERED, false);
+    main_thread->Init();
+
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 1;
+    }
+    internal::tAbstractBlackboardServer::tStatistics initial_statistics = blackboard.GetStatistics();
+
+    // Published buffer is not unique on commit - new buffer is required each time. Buffers replaced before are reused.
+    for (int i = 2; i <= 11; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+    }
+    internal::tAbstractBlackboardServer::tStatistics statistics = blackboard.GetStatistics();
+    RRLIB_UNIT_TESTS_ASSERT(statistics.buffer_reuse_misses == initial_statistics.buffer_reuse_misses);
+    RRLIB_UNIT_TESTS_ASSERT(statistics.buffer_reuse_hits == initial_statistics.buffer_reuse_hits + 10);
+
+    // Buffer locked by reader is not reused
+    tBlackboardClient<float>::tConstBufferPointer old_content = blackboard.GetClient().ReadLock().Get(std::chrono::seconds(2));
+    for (int i = 12; i <= 15; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+    }
+    RRLIB_UNIT_TESTS_ASSERT((*old_content)[0] == 11);
+    old_content.Reset();
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 15);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestDeltaPublishing()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestDeltaPublishing");
+
+    // create float blackboard with capacity 20 that publishes a keyframe every 4 deltas
+    typedef tBlackboardClient<float>::tServer::tDelta tDelta;
+    tBlackboard<float> blackboard("Delta Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetDeltaPublishing(4);
+    data_ports::tInputPort<tDelta> delta_input("Deltas", parent, data_ports::tQueueSettings(false, 16));
+    blackboard.GetDeltaPort().ConnectTo(delta_input);
+
+    // client maintains its copy from deltas
+    tBlackboardClient<float>& client = blackboard.GetClient();
+    client.EnableDeltaUpdates();
+    blackboard.GetDeltaPort().ConnectTo(client.GetDeltaPort());
+    main_thread->Init();
+
+    for (int i = 1; i <= 6; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[i] = i;
+    }
+
+    // first delta after enabling delta publishing is a keyframe - then every fourth delta
+    std::vector<uint64_t> revisions;
+    for (int i = 1; i <= 6; i++)
+    {
+      data_ports::tPortDataPointer<const tDelta> delta = delta_input.Dequeue();
+      RRLIB_UNIT_TESTS_ASSERT(delta.get() != NULL);
+      bool keyframe = (i == 1 || i == 5);
+      RRLIB_UNIT_TESTS_ASSERT(delta->IsKeyframe() == keyframe && delta->GetElementCount() == (keyframe ? 20u : 1u) && delta->GetBufferSize() == 20);
+      RRLIB_UNIT_TESTS_ASSERT(keyframe || delta->IsApplicableTo(revisions.back()));
+      revisions.push_back(delta->GetRevision());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(!delta_input.Dequeue());
+
+    // client's copy is up to date
+    tBlackboardClient<float>::tConstBufferPointer content = client.Read();
+    for (int i = 1; i <= 6; i++)
+    {
+      RRLIB_UNIT_TESTS_ASSERT((*content)[i] == i);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(client.GetRevision() == revisions.back());
+    content.Reset();
+    parent->ManagedDelete();
+  }
+
+  void TestShardWriteLocks()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestShardWriteLocks");
+
+    // create float blackboard with capacity 20 that is partitioned into 4 shards of 5 elements
+    tBlackboard<float> blackboard("Sharded Float Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetShardCount(4);
+    main_thread->Init();
+
+    {
+      // write accesses to disjoint shards can be held concurrently
+      tBlackboardWriteAccess<float> first_shard(blackboard, 0, 1);
+      tBlackboardWriteAccess<float> last_shards(blackboard, 2, 2);
+      first_shard[4] = 1;
+      last_shards[10] = 2;
+      last_shards[19] = 3;
+      RRLIB_UNIT_TESTS_ASSERT(first_shard.GetConst(10) == 0); // changes of other writer are not visible before commit
+      bool exception_thrown = false;
+      try
+      {
+        first_shard[5] = 4;
+      }
+      catch (const std::runtime_error&)
+      {
+        exception_thrown = true;
+      }
+      RRLIB_UNIT_TESTS_ASSERT(exception_thrown);
+    }
+
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[4] == 1 && read_access[5] == 0 && read_access[10] == 2 && read_access[19] == 3);
+    }
+
+    {
+      // write accesses to disjoint ranges (not aligned to shards) can be held concurrently
+      tBlackboardWriteAccess<float> first_range(blackboard, tElementRange(3, 7));
+      tBlackboardWriteAccess<float> second_range(blackboard, tElementRange(7, 8));
+      first_range[6] = 5;
+      second_range[7] = 6;
+    }
+
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[4] == 1 && read_access[6] == 5 && read_access[7] == 6 && read_access[10] == 2);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestOptimisticCommit()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestOptimisticCommit");
+    tBlackboard<float> blackboard("Optimistic Float Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    tBlackboardClient<float>& client = blackboard.GetClient();
+    main_thread->Init();
+
+    uint64_t revision = 0;
+    {
+      tBlackboardClient<float>::tConstBufferPointer snapshot = client.ReadSnapshot(revision);
+      tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+      change_set->clear();
+      change_set->push_back(tChange<float>(3, (*snapshot)[3] + 1));
+      RRLIB_UNIT_TESTS_ASSERT(client.CommitIfRevision(revision, change_set));
+    }
+
+    // commit based on outdated revision is rejected
+    tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<float>(3, 10));
+    RRLIB_UNIT_TESTS_ASSERT(!client.CommitIfRevision(revision, change_set));
+
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[3] == 1);
+    }
+
+    // with rate-limited publishing, consecutive commits do not conflict with pending publishes
+    blackboard.SetPublishingPolicy(tPublishingPolicy::MAX_RATE, std::chrono::seconds(10));
+    for (int i = 0; i < 3; i++)
+    {
+      tBlackboardClient<float>::tConstBufferPointer snapshot = client.ReadSnapshot(revision);
+      tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+      change_set->clear();
+      change_set->push_back(tChange<float>(4, (*snapshot)[4] + 1));
+      RRLIB_UNIT_TESTS_ASSERT(client.CommitIfRevision(revision, change_set));
+    }
+    change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<float>(4, 10));
+    RRLIB_UNIT_TESTS_ASSERT(!client.CommitIfRevision(revision - 1, change_set));
+    {
+      tBlackboardClient<float>::tConstBufferPointer snapshot = client.ReadSnapshot(revision);
+      RRLIB_UNIT_TESTS_ASSERT((*snapshot)[4] == 3 && blackboard.GetStatistics().optimistic_commit_conflicts == 2);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestRevisionRetention()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestRevisionRetention");
+    tBlackboard<float> blackboard("Retaining Float Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetRevisionRetention(3);
+    tBlackboardClient<float>& client = blackboard.GetClient();
+    main_thread->Init();
+
+    std::vector<uint64_t> revisions;
+    for (int i = 1; i <= 4; i++)
+    {
+      {
+        tBlackboardWriteAccess<float> write_access(blackboard);
+        write_access[0] = i;
+      }
+      revisions.push_back(client.GetRevision());
+    }
+
+    // only the last three revisions are retained
+    RRLIB_UNIT_TESTS_ASSERT(!client.ReadLockAtRevision(revisions[0]).Get(std::chrono::seconds(2)));
+    for (size_t i = 1; i < revisions.size(); i++)
+    {
+      tBlackboardClient<float>::tConstBufferPointer buffer = client.ReadLockAtRevision(revisions[i]).Get(std::chrono::seconds(2));
+      RRLIB_UNIT_TESTS_ASSERT(buffer && (*buffer)[0] == i + 1);
+    }
+    tBlackboardClient<float>::tConstBufferPointer latest = client.ReadLockAtTime(rrlib::time::Now()).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(latest && (*latest)[0] == 4);
+    latest.Reset();
+    parent->ManagedDelete();
+  }
+
+  void TestAdaptiveBufferMode()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestAdaptiveBufferMode");
+    tBlackboard<float> blackboard("Adaptive Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    tBlackboard<float> fixed_blackboard("Fixed Float Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    tBlackboardClient<float>& client = blackboard.GetClient();
+    main_thread->Init();
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetBufferMode() == tBufferMode::SINGLE_BUFFERED && blackboard.GetBufferModeReason() == tBufferModeReason::INITIAL);
+
+    // with read locks colliding with (exclusive) write locks, server switches to multi-buffered mode after one window
+    for (int i = 0; i < 16; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+      client.ReadLock(rrlib::time::tDuration::zero());
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetBufferMode() == tBufferMode::MULTI_BUFFERED && blackboard.GetBufferModeReason() == tBufferModeReason::READ_COLLISIONS);
+
+    // without any read locks during write locks, server switches back to single-buffered mode after one window
+    for (int i = 0; i < 16; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetBufferMode() == tBufferMode::SINGLE_BUFFERED && blackboard.GetBufferModeReason() == tBufferModeReason::LOW_CONTENTION);
+
+    // buffer mode specified explicitly is not changed adaptively
+    for (int i = 0; i < 16; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(fixed_blackboard);
+      write_access[0] = i;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(fixed_blackboard.GetBufferMode() == tBufferMode::MULTI_BUFFERED && fixed_blackboard.GetBufferModeReason() == tBufferModeReason::INITIAL);
+
+    blackboard.SetBufferMode(tBufferMode::MULTI_BUFFERED, false);
+    for (int i = 0; i < 16; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetBufferMode() == tBufferMode::MULTI_BUFFERED && blackboard.GetBufferModeReason() == tBufferModeReason::MANUAL);
+    parent->ManagedDelete();
+  }
+
+  void TestPublishingPolicies()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestPublishingPolicies");
+    tBlackboard<float> blackboard("Rate-limited Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+
+    // MAX_RATE: first change of a burst is published immediately - the trailing change once the interval has passed
+    blackboard.SetPublishingPolicy(tPublishingPolicy::MAX_RATE, std::chrono::milliseconds(200));
+    uint64_t revision = blackboard.GetRevision();
+    for (int i = 1; i <= 3; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision + 1 && blackboard.GetStatistics().suppressed_publishes == 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision + 2);
+
+    // PERIODIC: all changes of a period are published together at the end of the period
+    blackboard.SetPublishingPolicy(tPublishingPolicy::PERIODIC, std::chrono::milliseconds(200));
+    revision = blackboard.GetRevision();
+    for (int i = 4; i <= 6; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = i;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision + 1);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 6);
+    }
+
+    // Pending changes can be published before they are due
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 7;
+    }
+    blackboard.PublishPendingChanges();
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision + 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision + 2);  // nothing left to publish
+
+    // Zero interval: changes are published immediately
+    blackboard.SetPublishingPolicy(tPublishingPolicy::PERIODIC, rrlib::time::tDuration::zero());
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 8;
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetRevision() == revision + 3);
+    parent->ManagedDelete();
+  }
+
+  void TestLockRequestQueue()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestLockRequestQueue");
+    tBlackboard<float> blackboard("Queueing Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+    typedef internal::tLockedBuffer<std::vector<float>> tLockedBuffer;
+
+    // Pending write locks are granted in order of priority - and earliest timeout first among equal priorities
+    rpc_ports::tFuture<tLockedBuffer> low_priority, high_priority, early_timeout;
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 1;
+      low_priority = client.WriteLock(std::chrono::seconds(5), 0);
+      high_priority = client.WriteLock(std::chrono::seconds(5), 1);
+      early_timeout = client.WriteLock(std::chrono::seconds(3), 0);
+    }
+    float expected_previous = 1;
+    for (rpc_ports::tFuture<tLockedBuffer>* future : { &high_priority, &early_timeout, &low_priority })
+    {
+      tLockedBuffer locked_buffer = future->Get(std::chrono::seconds(1));  // throws if lock was not granted next
+      RRLIB_UNIT_TESTS_ASSERT(locked_buffer.GetConstElement(0) == expected_previous);
+      expected_previous++;
+      locked_buffer.GetElement(0) = expected_previous;
+      internal::tChangedRange changed_range;
+      changed_range.Add(0);
+      locked_buffer.CommitCurrentBuffer(changed_range);
+    }
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 4);
+    }
+
+    // Expired lock requests are rejected when their timeout is due (not only on the next lock operation)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 5;
+      rpc_ports::tFuture<tBlackboardClient<float>::tConstBufferPointer> read_lock = client.ReadLock(std::chrono::milliseconds(100));
+      rpc_ports::tFuture<tLockedBuffer> write_lock = client.WriteLock(std::chrono::milliseconds(100));
+      std::this_thread::sleep_for(std::chrono::milliseconds(400));
+      rpc_ports::tFutureStatus read_lock_status = rpc_ports::tFutureStatus::READY, write_lock_status = rpc_ports::tFutureStatus::READY;
+      try
+      {
+        read_lock.Get(rrlib::time::tDuration::zero());
+      }
+      catch (const rpc_ports::tRPCException& e)
+      {
+        read_lock_status = e.GetType();
+      }
+      try
+      {
+        write_lock.Get(rrlib::time::tDuration::zero());
+      }
+      catch (const rpc_ports::tRPCException& e)
+      {
+        write_lock_status = e.GetType();
+      }
+      RRLIB_UNIT_TESTS_ASSERT(read_lock_status == rpc_ports::tFutureStatus::BROKEN_PROMISE && write_lock_status == rpc_ports::tFutureStatus::BROKEN_PROMISE);
+    }
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 5);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestLockLeases()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestLockLeases");
+    internal::tBlackboardServer<float>* server = new internal::tBlackboardServer<float>("Leased Float Blackboard", parent, false, 20, false);
+    server->SetLockLeaseDuration(std::chrono::milliseconds(100));
+    main_thread->Init();
+    typedef internal::tLockedBuffer<std::vector<float>> tLockedBuffer;
+
+    // Lock parameters are marked as remote call on deserialization
+    internal::tLockParameters lock_parameters(std::chrono::seconds(1)), remote_lock_parameters;
+    rrlib::serialization::tMemoryBuffer memory_buffer;
+    rrlib::serialization::tOutputStream output_stream(memory_buffer);
+    output_stream << lock_parameters;
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(memory_buffer);
+    input_stream >> remote_lock_parameters;
+    RRLIB_UNIT_TESTS_ASSERT((!lock_parameters.IsRemoteCall()) && remote_lock_parameters.IsRemoteCall());
+
+    // Remote write lock that is not renewed is revoked when its lease expires (without any further blackboard operations) - late commit is skipped
+    tLockedBuffer locked_buffer = server->WriteLock(remote_lock_parameters).Get(std::chrono::seconds(1));
+    locked_buffer.GetElement(0) = 1;
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    RRLIB_UNIT_TESTS_ASSERT(server->GetStatistics().expired_lock_leases == 1);
+    locked_buffer.CommitCurrentBuffer();
+    RRLIB_UNIT_TESTS_ASSERT((*server->ReadLock(std::chrono::seconds(1)).Get(std::chrono::seconds(1)))[0] == 0);
+
+    // Remote write lock whose lease is renewed is kept
+    locked_buffer = server->WriteLock(remote_lock_parameters).Get(std::chrono::seconds(1));
+    for (int i = 0; i < 8; i++)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      server->RenewLockLease(locked_buffer.GetLockId());
+    }
+    locked_buffer.GetElement(0) = 2;
+    locked_buffer.CommitCurrentBuffer();
+    RRLIB_UNIT_TESTS_ASSERT((*server->ReadLock(std::chrono::seconds(1)).Get(std::chrono::seconds(1)))[0] == 2);
+    RRLIB_UNIT_TESTS_ASSERT(server->GetStatistics().expired_lock_leases == 1);
+    parent->ManagedDelete();
+  }
+
+  void TestElementOperations()
+  {
+    // memcpy is only used for trivially copyable types - not for bool (std::vector<bool> does not store its elements in an array)
+    RRLIB_UNIT_TESTS_ASSERT(internal::tIsTriviallyCopyable<float>::value && internal::tIsTriviallyCopyable<tTestPoint>::value);
+    RRLIB_UNIT_TESTS_ASSERT((!internal::tIsTriviallyCopyable<bool>::value) && (!internal::tIsTriviallyCopyable<std::string>::value));
+
+    // memcpy path yields the same result as element-wise deep copies
+    std::vector<tTestPoint> points = { { 1, 0.5 }, { 2, 1.5 }, { 3, 2.5 }, { 4, 3.5 } };
+    std::vector<tTestPoint> copied_points(4, tTestPoint { 0, 0 }), deep_copied_points(4, tTestPoint { 0, 0 }), moved_points(4, tTestPoint { 0, 0 });
+    internal::tElementOperations<tTestPoint>::Copy(points, 1, copied_points, 1, 3);
+    for (size_t i = 1; i < 4; i++)
+    {
+      rrlib::rtti::GenericOperations<tTestPoint>::DeepCopy(points[i], deep_copied_points[i]);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(copied_points == deep_copied_points && copied_points[0] == (tTestPoint { 0, 0 }));
+    internal::tElementOperations<tTestPoint>::Move(points, 0, moved_points, 0, 4);
+    RRLIB_UNIT_TESTS_ASSERT(moved_points == points);
+
+    // generic path for non-trivial types: target elements are deep copies (storage is reused), moved elements are swapped
+    std::vector<std::string> strings = { "first", "second", "a string that does not fit into small string buffers" };
+    std::vector<std::string> copied_strings = { "x", "y", "z" }, deep_copied_strings = { "x", "y", "z" };
+    internal::tElementOperations<std::string>::Copy(strings, 0, copied_strings, 0, 3);
+    for (size_t i = 0; i < 3; i++)
+    {
+      rrlib::rtti::GenericOperations<std::string>::DeepCopy(strings[i], deep_copied_strings[i]);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(copied_strings == deep_copied_strings && copied_strings == strings);
+    std::vector<std::string> moved_strings(3);
+    internal::tElementOperations<std::string>::Move(copied_strings, 0, moved_strings, 0, 3);
+    RRLIB_UNIT_TESTS_ASSERT(moved_strings == strings);
+
+    // bulk serialization of arithmetic types yields the same data as serializing elements one by one
+    std::vector<float> values = { 1.5f, -2.f, 3.25f, 0.f, 1e10f };
+    rrlib::serialization::tMemoryBuffer memory_buffer;
+    rrlib::serialization::tOutputStream output_stream(memory_buffer);
+    internal::tElementOperations<float>::Serialize(output_stream, values, 0, values.size());
+    for (float value : values)
+    {
+      output_stream << value;
+    }
+    internal::tElementOperations<std::string>::Serialize(output_stream, strings, 0, strings.size());
+    std::vector<bool> flags = { true, false, true };
+    internal::tElementOperations<bool>::Serialize(output_stream, flags, 0, flags.size());
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(memory_buffer);
+    for (float value : values)
+    {
+      float deserialized = 0;
+      input_stream >> deserialized;
+      RRLIB_UNIT_TESTS_ASSERT(deserialized == value);
+    }
+    std::vector<float> deserialized_values(values.size());
+    internal::tElementOperations<float>::Deserialize(input_stream, deserialized_values, 0, deserialized_values.size());
+    std::vector<std::string> deserialized_strings(strings.size());
+    internal::tElementOperations<std::string>::Deserialize(input_stream, deserialized_strings, 0, deserialized_strings.size());
+    std::vector<bool> deserialized_flags(flags.size());
+    internal::tElementOperations<bool>::Deserialize(input_stream, deserialized_flags, 0, deserialized_flags.size());
+    RRLIB_UNIT_TESTS_ASSERT(deserialized_values == values && deserialized_strings == strings && deserialized_flags == flags);
+
+    // std::vector<bool> uses the element-wise path
+    std::vector<bool> copied_flags(4, false);
+    internal::tElementOperations<bool>::Copy(flags, 0, copied_flags, 1, 3);
+    RRLIB_UNIT_TESTS_ASSERT((!copied_flags[0]) && copied_flags[1] && (!copied_flags[2]) && copied_flags[3]);
+  }
+
+  void TestBoolBlackboard()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestBoolBlackboard");
+    tBlackboard<bool> blackboard("Bool Blackboard", parent, true, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetChunkedCopyOnWrite(4);
+    blackboard.SetDeltaPublishing(4);
+    tBlackboardClient<bool>& client = blackboard.GetClient();
+    client.EnableDeltaUpdates();
+    blackboard.GetDeltaPort().ConnectTo(client.GetDeltaPort());
+    main_thread->Init();
+
+    {
+      tBlackboardWriteAccess<bool> write_access(blackboard);
+      write_access[3] = true;
+      write_access[17] = write_access.GetConst(3);
+    }
+    tBlackboardClient<bool>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<bool>(5, true));
+    change_set->push_back(tChange<bool>::CompareAndSwap(6, false, true));
+    change_set->push_back(tChange<bool>::Insert(0, false));
+    client.AsynchronousChange(change_set);
+
+    // content is read from replica maintained from deltas
+    tBlackboardClient<bool>::tConstBufferPointer content = client.Read();
+    RRLIB_UNIT_TESTS_ASSERT(content->size() == 21 && (*content)[4] && (*content)[6] && (*content)[7] && (*content)[18] && (!(*content)[0]) && (!(*content)[5]));
+    parent->ManagedDelete();
+  }
+
+  void TestTripleBuffering()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestTripleBuffering");
+    tBlackboard<float> blackboard("Triple-buffered Float Blackboard", parent, tBufferMode::TRIPLE_BUFFERED, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+
+    for (int i = 1; i <= 5; i++)
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);  // reader holding front buffer does not block writer
+      {
+        tBlackboardWriteAccess<float> write_access(blackboard);
+        RRLIB_UNIT_TESTS_ASSERT(write_access[0] == i - 1 && write_access[i] == 0); // back buffer is up to date
+        write_access[0] = i;
+        write_access[i] = i;
+      }
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == i - 1);
+    }
+
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      for (int i = 1; i <= 5; i++)
+      {
+        RRLIB_UNIT_TESTS_ASSERT(read_access[i] == i);
+      }
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 5);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetBufferMode() == tBufferMode::TRIPLE_BUFFERED);
+    parent->ManagedDelete();
+  }
+
+  void TestSeqlockReads()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestSeqlockReads");
+    tBlackboard<float> blackboard("Seqlock Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    std::vector<float> copy;
+    client.ReadCopy(copy);
+    RRLIB_UNIT_TESTS_ASSERT(copy.size() == 20 && copy[3] == 0);
+    for (int i = 1; i <= 3; i++)
+    {
+      {
+        tBlackboardWriteAccess<float> write_access(client);
+        write_access[3] = i;
+        if (i == 3)
+        {
+          write_access.Resize(30);  // seqlock storage grows
+        }
+      }
+      client.ReadCopy(copy);
+      RRLIB_UNIT_TESTS_ASSERT(copy[3] == i && copy.size() == (i == 3 ? 30u : 20u));
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestLockFreeReads()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestLockFreeReads");
+    tBlackboard<float> multi_buffered("Multi-buffered Float Blackboard", parent, tBufferMode::MULTI_BUFFERED, 20, true, tReadPorts::NONE, NULL);
+    tBlackboard<float> single_buffered("Single-buffered Float Blackboard", parent, tBufferMode::SINGLE_BUFFERED, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = multi_buffered.GetClient();
+
+    // Multi-buffered: published buffer can be read-locked while write lock is held
+    tBlackboardClient<float>::tConstBufferPointer old_content = client.ReadLock().Get(std::chrono::seconds(2));
+    {
+      tBlackboardWriteAccess<float> write_access(multi_buffered);
+      write_access[0] = 1;
+      tBlackboardClient<float>::tConstBufferPointer content = client.ReadLock(rrlib::time::tDuration::zero()).Get(std::chrono::seconds(2));
+      RRLIB_UNIT_TESTS_ASSERT(content && (*content)[0] == 0);
+    }
+    tBlackboardClient<float>::tConstBufferPointer new_content = client.ReadLock(rrlib::time::tDuration::zero()).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(new_content && (*new_content)[0] == 1 && (*old_content)[0] == 0);  // new buffer is published after commit
+    old_content.Reset();
+    new_content.Reset();
+
+    // Single-buffered: buffer is retracted while blackboard is locked exclusively
+    {
+      tBlackboardWriteAccess<float> write_access(single_buffered);
+      write_access[0] = 2;
+      bool exception_thrown = false;
+      try
+      {
+        single_buffered.GetClient().ReadLock(rrlib::time::tDuration::zero()).Get(std::chrono::seconds(2));
+      }
+      catch (const rpc_ports::tRPCException&)
+      {
+        exception_thrown = true;
+      }
+      RRLIB_UNIT_TESTS_ASSERT(exception_thrown);
+    }
+    new_content = single_buffered.GetClient().ReadLock(rrlib::time::tDuration::zero()).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(new_content && (*new_content)[0] == 2);  // buffer is published again after unlock
+    new_content.Reset();
+    parent->ManagedDelete();
+  }
+
+  void TestReadDelta()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestReadDelta");
+    tBlackboard<float> blackboard("Delta Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    // Initial read returns keyframe
+    typedef tBlackboardClient<float>::tServer::tDelta tDelta;
+    std::vector<float> copy;
+    tDelta delta = client.ReadDelta(std::numeric_limits<uint64_t>::max()).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(delta.IsKeyframe() && delta.GetElementCount() == 20);
+    delta.Apply(copy);
+    uint64_t revision = delta.GetRevision();
+
+    // Content has not changed
+    delta = client.ReadDelta(revision).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT((!delta.IsKeyframe()) && delta.GetElementCount() == 0 && delta.GetRevision() == revision);
+
+    // Only changed elements are transferred (also if revisions were skipped)
+    for (int i = 1; i <= 3; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(client);
+      write_access[4 + i] = i;
+    }
+    delta = client.ReadDelta(revision).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT((!delta.IsKeyframe()) && delta.IsApplicableTo(revision) && delta.GetElementCount() == 3);
+    delta.Apply(copy);
+    RRLIB_UNIT_TESTS_ASSERT(copy.size() == 20 && copy[4] == 0 && copy[5] == 1 && copy[6] == 2 && copy[7] == 3);
+
+    // Unknown revision
+    delta = client.ReadDelta(delta.GetRevision() + 1).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(delta.IsKeyframe());
+    parent->ManagedDelete();
+  }
+
+  void TestCompression()
+  {
+    std::vector<float> content(1000), decoded_content;
+    for (size_t i = 0; i < content.size(); i++)
+    {
+      content[i] = (i / 100) * 0.5f;
+    }
+    for (tCompression compression : { tCompression::NONE, tCompression::LZ, tCompression::SHUFFLE_DELTA_LZ })
+    {
+      internal::tBlackboardDelta<float> delta, decoded_delta;
+      delta.Set(content, 1, 0, content.size(), true);
+      delta.SetCompression(compression);
+      rrlib::serialization::tMemoryBuffer memory_buffer;
+      rrlib::serialization::tOutputStream output_stream(memory_buffer);
+      output_stream << delta;
+      output_stream.Close();
+      RRLIB_UNIT_TESTS_ASSERT((compression == tCompression::NONE) == (memory_buffer.GetSize() > content.size() * sizeof(float)));
+      rrlib::serialization::tInputStream input_stream(memory_buffer);
+      input_stream >> decoded_delta;
+      decoded_delta.Apply(decoded_content);
+      RRLIB_UNIT_TESTS_ASSERT(decoded_content == content);
+    }
+  }
+
+  void TestRemoteReplica()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestRemoteReplica");
+    tBlackboard<float> blackboard("Origin Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    blackboard.SetDeltaPublishing(4);
+    internal::tRemoteBlackboardServer<float>* replica = new internal::tRemoteBlackboardServer<float>("Replica", parent);
+    replica->GetWritePort().ConnectTo(*blackboard.GetWritePort().GetWrapped());
+    blackboard.GetDeltaPort().ConnectTo(replica->GetDeltaPort());
+
+    // Regular blackboard client served by replica
+    tBlackboardClient<float> client("Replica Client", parent, true);
+    replica->GetReadPort().ConnectTo(*client.GetBackend()->GetReadPort());
+    replica->GetWritePort().ConnectTo(*client.GetBackend()->GetWritePort());
+    main_thread->Init();
+
+    // Replica has no content before it is synchronized
+    RRLIB_UNIT_TESTS_ASSERT(replica->GetStaleness().revisions == std::numeric_limits<uint64_t>::max());
+    replica->Synchronize();
+    RRLIB_UNIT_TESTS_ASSERT(client.Read()->size() == 20);
+
+    // Writes are forwarded to origin - and replica is updated from published deltas (by blackboard timer thread)
+    for (int i = 1; i <= 3; i++)
+    {
+      tBlackboardWriteAccess<float> write_access(client);
+      write_access[4 + i] = i;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    tBlackboardClient<float>::tConstBufferPointer content = client.Read();
+    RRLIB_UNIT_TESTS_ASSERT(content->size() == 20 && (*content)[5] == 1 && (*content)[6] == 2 && (*content)[7] == 3);
+    internal::tRemoteBlackboardServer<float>::tStaleness staleness = replica->GetStaleness();
+    RRLIB_UNIT_TESTS_ASSERT(staleness.revisions == 0 && staleness.age == rrlib::time::tDuration::zero());
+    {
+      tBlackboardReadAccess<float> read_access(client);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[7] == 3);
+    }
+
+    // Buffer locked by reader is not modified
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard.GetClient());
+      write_access[5] = 10;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    RRLIB_UNIT_TESTS_ASSERT((*content)[5] == 1 && (*client.Read())[5] == 10);
+    parent->ManagedDelete();
+  }
+
+  void TestChangeSetEncoding()
+  {
+    std::vector<tChange<float>> change_set, decoded_change_set;
+    change_set.emplace_back(7, 7);
+    change_set.emplace_back(3, 3);
+    change_set.emplace_back(4, 4);
+    change_set.emplace_back(5, 5);
+    change_set.emplace_back();
+    change_set.emplace_back(2, std::vector<float>({ 20, 21, 22 }));
+    change_set.emplace_back(3, 8);
+    change_set.emplace_back(1000, 1);
+
+    rrlib::serialization::tMemoryBuffer memory_buffer;
+    rrlib::serialization::tOutputStream output_stream(memory_buffer);
+    output_stream << change_set;
+    output_stream.Close();
+    rrlib::serialization::tInputStream input_stream(memory_buffer);
+    input_stream >> decoded_change_set;
+    RRLIB_UNIT_TESTS_ASSERT(decoded_change_set.size() == change_set.size());
+
+    // applying decoded change set has the same result
+    std::vector<float> expected(1001, 0), result(1001, 0);
+    for (auto & change : change_set)
+    {
+      change.Apply(expected);
+    }
+    for (auto & change : decoded_change_set)
+    {
+      change.Apply(result);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(result == expected && result[2] == 20 && result[3] == 8 && result[4] == 22 && result[1000] == 1);
+  }
+
+  void TestRangeChanges()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestRangeChanges");
+    tBlackboard<float> blackboard("Range Change Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    std::vector<float> source = { 1, 2, 3, 4, 5 };
+    tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<float>(10, 9));
+    change_set->push_back(tChange<float>(8, source.data(), source.size()));
+    change_set->push_back(tChange<float>(18, source.data(), source.size()));  // out of bounds - ignored
+    change_set->push_back(tChange<float>(12, 7));
+    client.AsynchronousChange(change_set);
+
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[8] == 1 && read_access[10] == 3 && read_access[12] == 7 && read_access[18] == 0);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestChangeCoalescing()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestChangeCoalescing");
+    tBlackboard<float> blackboard("Coalescing Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    // Replace changes to the same element in several deferred change sets: only the last one is applied
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 9;
+      for (int i = 1; i <= 3; i++)
+      {
+        tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+        change_set->clear();
+        change_set->push_back(tChange<float>(3, i));
+        change_set->push_back(tChange<float>(4 + i, i));
+        if (i == 2)
+        {
+          change_set->push_back(tChange<float>(3, 10));
+        }
+        client.AsynchronousChange(change_set);
+      }
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetStatistics().coalesced_changes == 3);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 9 && read_access[3] == 3 && read_access[5] == 1 && read_access[6] == 2 && read_access[7] == 3);
+    }
+
+    // Deferred change sets containing other operations are applied in order without coalescing
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 8;
+      tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+      change_set->clear();
+      change_set->push_back(tChange<float>(3, 1));
+      client.AsynchronousChange(change_set);
+      change_set = client.GetUnusedChangeBuffer();
+      change_set->clear();
+      change_set->push_back(tChange<float>::Add(3, 2));
+      client.AsynchronousChange(change_set);
+    }
+    RRLIB_UNIT_TESTS_ASSERT(blackboard.GetStatistics().coalesced_changes == 3);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 8 && read_access[3] == 3);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestChangedRangeTracking()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestChangedRangeTracking");
+    tBlackboard<float> blackboard("Range Tracking Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    typedef tBlackboardClient<float>::tServer::tDelta tDelta;
+    std::vector<float> copy, expected;
+    tDelta delta = client.ReadDelta(std::numeric_limits<uint64_t>::max()).Get(std::chrono::seconds(2));
+    delta.Apply(copy);
+
+    // Elements accessed via Get() and operator[] are tracked (as bounding range)
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access.Get(12) = 1;
+      write_access[9] = 2;
+    }
+    delta = client.ReadDelta(delta.GetRevision()).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT((!delta.IsKeyframe()) && delta.GetElementCount() == 4);
+    delta.Apply(copy);
+    RRLIB_UNIT_TESTS_ASSERT(copy.size() == 20 && copy[9] == 2 && copy[12] == 1);
+
+    // Reading size does not mark anything as changed
+    uint64_t revision = delta.GetRevision();
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(write_access.Size() == 20);
+    }
+    delta = client.ReadDelta(revision).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT((!delta.IsKeyframe()) && delta.GetElementCount() == 0);
+
+    // Growing marks new elements as changed
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access.Resize(24);
+      write_access[23] = 3;
+    }
+    delta = client.ReadDelta(revision).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT((!delta.IsKeyframe()) && delta.GetBufferSize() == 24 && delta.GetElementCount() == 4);
+    delta.Apply(copy);
+    RRLIB_UNIT_TESTS_ASSERT(copy.size() == 24 && copy[12] == 1 && copy[20] == 0 && copy[23] == 3);
+
+    // Shrinking truncates replica - changed elements before new end are transferred
+    revision = delta.GetRevision();
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access.Resize(22);
+      write_access[15] = 4;
+    }
+    delta = client.ReadDelta(revision).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT((!delta.IsKeyframe()) && delta.GetBufferSize() == 22 && delta.GetElementCount() < 22);
+    delta.Apply(copy);
+    client.ReadCopy(expected);
+    RRLIB_UNIT_TESTS_ASSERT(copy == expected && copy.size() == 22 && copy[15] == 4);
+    parent->ManagedDelete();
+  }
+
+  void TestChangedRangeSerialization()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestChangedRangeSerialization");
+    tBlackboard<float> blackboard("Serialized Float Blackboard", parent, false, 20, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    typedef internal::tLockedBufferData<std::vector<float>> tData;
+
+    // Ranges are unknown/complete by default
+    {
+      tData data, decoded_data;
+      rrlib::serialization::tMemoryBuffer memory_buffer;
+      rrlib::serialization::tOutputStream output_stream(memory_buffer);
+      output_stream << data;
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(memory_buffer);
+      input_stream >> decoded_data;
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetChangedRange().IsComplete() && decoded_data.GetWritableRange().IsComplete());
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetBufferSize() == tData::cUNCHANGED_BUFFER_SIZE && decoded_data.GetModifiedChunks().empty());
+    }
+
+    // Partial ranges
+    {
+      data_ports::tPortDataPointer<std::vector<float>> buffer = blackboard.GetReadPort().GetUnusedBuffer();
+      buffer->assign(20, 0);
+      (*buffer)[5] = 5;
+      tData data(std::move(buffer), 7), decoded_data;
+      internal::tChangedRange changed_range, writable_range;
+      changed_range.Add(5);
+      writable_range.Add(4, 8);
+      data.SetChangedRange(changed_range);
+      data.SetWritableRange(writable_range);
+      rrlib::serialization::tMemoryBuffer memory_buffer;
+      rrlib::serialization::tOutputStream output_stream(memory_buffer);
+      output_stream << data;
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(memory_buffer);
+      input_stream >> decoded_data;
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetChangedRange().GetBegin() == 5 && decoded_data.GetChangedRange().GetEnd() == 6);
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetWritableRange().GetBegin() == 4 && decoded_data.GetWritableRange().GetEnd() == 8);
+
+      // only changed elements are transferred (range-lock commit)
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetBufferSize() == 20 && decoded_data.GetModifiedChunks().size() == 1);
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetModifiedChunks()[0].offset == 5 && decoded_data.GetModifiedChunks()[0].elements == std::vector<float>({ 5 }));
+    }
+
+    // Resized buffer: new size and changed elements are transferred
+    for (size_t new_size : { 23, 15 })
+    {
+      data_ports::tPortDataPointer<std::vector<float>> buffer = blackboard.GetReadPort().GetUnusedBuffer();
+      buffer->assign(new_size, 0);
+      (*buffer)[3] = 3;
+      tData data(std::move(buffer), 8), decoded_data;
+      internal::tChangedRange changed_range;
+      changed_range.Add(3);
+      changed_range.Add(std::min<size_t>(20, new_size), std::max<size_t>(20, new_size));
+      data.SetChangedRange(changed_range);
+      rrlib::serialization::tMemoryBuffer memory_buffer;
+      rrlib::serialization::tOutputStream output_stream(memory_buffer);
+      output_stream << data;
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(memory_buffer);
+      input_stream >> decoded_data;
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetBufferSize() == new_size && decoded_data.GetModifiedChunks().size() == 1);
+      const std::vector<float>& elements = decoded_data.GetModifiedChunks()[0].elements;
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetModifiedChunks()[0].offset == 3 && elements.size() == new_size - 3 && elements[0] == 3);
+    }
+
+    // Empty range
+    {
+      tData data, decoded_data;
+      data.SetChangedRange(internal::tChangedRange());
+      rrlib::serialization::tMemoryBuffer memory_buffer;
+      rrlib::serialization::tOutputStream output_stream(memory_buffer);
+      output_stream << data;
+      output_stream.Close();
+      rrlib::serialization::tInputStream input_stream(memory_buffer);
+      input_stream >> decoded_data;
+      RRLIB_UNIT_TESTS_ASSERT(decoded_data.GetChangedRange().IsEmpty() && decoded_data.GetWritableRange().IsComplete());
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestStructuralChanges()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestStructuralChanges");
+    tBlackboard<float> blackboard("List Float Blackboard", parent, false, 0, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<float>::Append(std::vector<float>({ 1, 2, 3 })));
+    change_set->push_back(tChange<float>::Insert(0, 0));
+    change_set->push_back(tChange<float>(3, 5));  // changes are applied in order: replaces element 2 (now at index 3)
+    change_set->push_back(tChange<float>::Append(4));
+    change_set->push_back(tChange<float>::Erase(1));
+    client.AsynchronousChange(change_set);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access.Size() == 4 && read_access[0] == 0 && read_access[1] == 2 && read_access[2] == 5 && read_access[3] == 4);
+    }
+
+    change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<float>::Truncate(2));
+    change_set->push_back(tChange<float>::Resize(3));
+    client.AsynchronousChange(change_set);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access.Size() == 3 && read_access[1] == 2 && read_access[2] == 0);
+    }
+    parent->ManagedDelete();
+  }
+
+  void TestAtomicOperations()
+  {
+    core::tFrameworkElement* parent = new core::tFrameworkElement(main_thread, "TestAtomicOperations");
+    tBlackboard<float> blackboard("Float Blackboard", parent, false, 4, true, tReadPorts::NONE, NULL);
+    main_thread->Init();
+    tBlackboardClient<float>& client = blackboard.GetClient();
+
+    tBlackboardClient<float>::tChangeSetPointer change_set = client.GetUnusedChangeBuffer();
+    change_set->clear();
+    change_set->push_back(tChange<float>::Add(0, 2));
+    change_set->push_back(tChange<float>::Add(0, 3));
+    change_set->push_back(tChange<float>::Max(1, 7));
+    change_set->push_back(tChange<float>::Min(1, 4));
+    change_set->push_back(tChange<float>::CompareAndSwap(2, 0, 1));
+    change_set->push_back(tChange<float>::CompareAndSwap(3, 1, 2)); // fails
+    std::vector<float> results = client.AsynchronousChangeWithResults(change_set).Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(results == std::vector<float>({ 0, 2, 0, 7, 0, 0 }));
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 5 && read_access[1] == 4 && read_access[2] == 1 && read_access[3] == 0);
+    }
+
+    // Failed compare-and-swap does not change any elements (but provides previous value)
+    std::vector<float> buffer = { 0, 3 };
+    tChange<float> compare_and_swap = tChange<float>::CompareAndSwap(1, 1, 2);
+    tElementRange changed_range = compare_and_swap.Apply(buffer);
+    RRLIB_UNIT_TESTS_ASSERT(changed_range.begin == changed_range.end && buffer[1] == 3 && compare_and_swap.GetPreviousElement() == 3);
+    compare_and_swap = tChange<float>::CompareAndSwap(1, 3, 2);
+    changed_range = compare_and_swap.Apply(buffer);
+    RRLIB_UNIT_TESTS_ASSERT(changed_range.begin == 1 && changed_range.end == 2 && buffer[1] == 2 && compare_and_swap.GetPreviousElement() == 3);
+
+    // Changes with results are deferred while blackboard is locked
+    rpc_ports::tFuture<std::vector<float>> future;
+    {
+      tBlackboardWriteAccess<float> write_access(blackboard);
+      write_access[0] = 10;
+      change_set = client.GetUnusedChangeBuffer();
+      change_set->clear();
+      change_set->push_back(tChange<float>::Add(0, 1));
+      future = client.AsynchronousChangeWithResults(change_set);
+    }
+    results = future.Get(std::chrono::seconds(2));
+    RRLIB_UNIT_TESTS_ASSERT(results.size() == 1 && results[0] == 10);
+    {
+      tBlackboardReadAccess<float> read_access(blackboard);
+      RRLIB_UNIT_TESTS_ASSERT(read_access[0] == 11);
+    }
+    parent->ManagedDelete();
+  }
+
   void CheckVector(const std::vector<float> blackboard_values, size_t iteration)
   {
     RRLIB_UNIT_TESTS_ASSERT(blackboard_values.size() == 20);